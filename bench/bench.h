@@ -0,0 +1,27 @@
+#ifndef SPDA_BENCH_H_
+#define SPDA_BENCH_H_
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+/* Monotonic wall clock in seconds */
+static inline double bench_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Small deterministic generator so every run replays the same workload */
+static inline uint64_t bench_rand(uint64_t *state)
+{
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return *state >> 33;
+}
+
+#define bench_report(name, seconds, ops) \
+    printf("  %-32s %10.3f ms  %12.1f ns/op\n", (name), (seconds) * 1e3, (seconds) * 1e9 / (double)(ops))
+
+#endif // SPDA_BENCH_H_
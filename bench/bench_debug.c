@@ -0,0 +1,58 @@
+#include "bench.h"
+#include <stdlib.h>
+#include "../spda.h"
+
+/*
+* Cost of the debug checks. `make bench` builds this file twice: bench_debug
+* as a release build, where spda_at must cost exactly what plain indexing does
+* and the header must stay three fields, and bench_debug_checked with
+* -DSPDA_DEBUG to show what the checks cost when they are on.
+*/
+
+#define N 4000000
+#define ROUNDS 5
+
+int main(void)
+{
+#ifdef SPDA_DEBUG
+    printf("Debug checks (SPDA_DEBUG on, %zu byte header)\n", (size_t)FIELD_COUNT * sizeof(size_t));
+#else
+    printf("Debug checks (release build, %zu byte header)\n", (size_t)FIELD_COUNT * sizeof(size_t));
+#endif
+
+    double t0 = bench_now();
+    int *a = spda_create(int);
+    for (int i = 0; i < N; ++i) spda_append(a, i);
+    bench_report("spda_append", bench_now() - t0, N);
+
+    uint64_t rng = 5;
+    size_t *idx = malloc(N * sizeof(size_t));
+    for (size_t i = 0; i < N; ++i) idx[i] = bench_rand(&rng) % N;
+
+    long long raw_sum = 0, checked_sum = 0;
+    t0 = bench_now();
+    for (int r = 0; r < ROUNDS; ++r) {
+        for (size_t i = 0; i < N; ++i) raw_sum += a[idx[i]];
+    }
+    bench_report("plain a[i]", bench_now() - t0, (size_t)N * ROUNDS);
+
+    t0 = bench_now();
+    for (int r = 0; r < ROUNDS; ++r) {
+        for (size_t i = 0; i < N; ++i) checked_sum += spda_at(a, idx[i]);
+    }
+    bench_report("spda_at(a, i)", bench_now() - t0, (size_t)N * ROUNDS);
+
+    t0 = bench_now();
+    for (int i = 0; i < N; ++i) spda_pop(a);
+    bench_report("spda_pop", bench_now() - t0, N);
+
+    bool ok = raw_sum == checked_sum && spda_len(a) == 0 && spda_check(a);
+#ifndef SPDA_DEBUG
+    ok = ok && FIELD_COUNT == 3 && spda_generation(a) == 0;
+#endif
+    printf("  results match: %s\n", ok ? "yes" : "NO");
+
+    free(idx);
+    spda_destroy(a);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,102 @@
+#include "bench.h"
+#include <stdlib.h>
+#include <string.h>
+#include "../spda.h"
+#include "../spda_edit.h"
+
+/*
+* Replays an editor-like trace (clustered inserts/removes around a cursor that
+* occasionally jumps) against a plain spda array, a gap buffer and a rope.
+*/
+
+#define DOC_SIZE   (1u << 20)      // 1 MiB document
+#define EDIT_COUNT 20000
+#define JUMP_EVERY 256             // cursor teleports every N edits
+
+typedef struct {
+    bool insert;
+    size_t pos;
+    char ch;
+} Edit;
+
+static Edit *make_trace(size_t doc_len, size_t count)
+{
+    Edit *trace = malloc(count * sizeof(Edit));
+    uint64_t rng = 42;
+    size_t len = doc_len, cursor = doc_len / 2;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i % JUMP_EVERY == 0) cursor = bench_rand(&rng) % (len + 1);
+        else {
+            long delta = (long)(bench_rand(&rng) % 17) - 8;
+            if (delta < 0 && (size_t)(-delta) > cursor) cursor = 0;
+            else cursor += delta;
+            if (cursor > len) cursor = len;
+        }
+
+        bool insert = (bench_rand(&rng) % 5) != 0 || len == 0 || cursor == len;
+        trace[i] = (Edit){ .insert = insert, .pos = cursor, .ch = (char)('a' + i % 26) };
+        if (insert) { len++; cursor++; }
+        else len--;
+    }
+    return trace;
+}
+
+int main(void)
+{
+    printf("Edit trace replay (%u byte document, %d edits)\n", DOC_SIZE, EDIT_COUNT);
+
+    char *doc = spda_reserve(char, DOC_SIZE);
+    for (size_t i = 0; i < DOC_SIZE; ++i) doc[i] = (char)('A' + i % 26);
+    spda_set_length(doc, DOC_SIZE);
+
+    Edit *trace = make_trace(DOC_SIZE, EDIT_COUNT);
+
+    /* Plain spda_insert / spda_remove */
+    char *plain = spda_reserve(char, DOC_SIZE);
+    spda_append_items(plain, doc, DOC_SIZE);
+    double t0 = bench_now();
+    for (size_t i = 0; i < EDIT_COUNT; ++i)
+    {
+        if (trace[i].insert) spda_insert(plain, (int)trace[i].pos, trace[i].ch);
+        else spda_remove(plain, (int)trace[i].pos);
+    }
+    bench_report("spda_insert/spda_remove", bench_now() - t0, EDIT_COUNT);
+
+    /* Gap buffer */
+    char *gap_src = spda_reserve(char, DOC_SIZE);
+    spda_append_items(gap_src, doc, DOC_SIZE);
+    SpdaGap *gb = spda_gap_from(gap_src);
+    t0 = bench_now();
+    for (size_t i = 0; i < EDIT_COUNT; ++i)
+    {
+        if (trace[i].insert) spda_gap_insert(gb, trace[i].pos, &trace[i].ch);
+        else spda_gap_remove(gb, trace[i].pos, 1);
+    }
+    bench_report("gap buffer", bench_now() - t0, EDIT_COUNT);
+    char *gap_view = spda_gap_view(gb);
+
+    /* Rope */
+    SpdaRope *rope = spda_rope_from(doc);
+    t0 = bench_now();
+    for (size_t i = 0; i < EDIT_COUNT; ++i)
+    {
+        if (trace[i].insert) spda_rope_insert(rope, trace[i].pos, &trace[i].ch);
+        else spda_rope_remove(rope, trace[i].pos);
+    }
+    bench_report("chunked rope", bench_now() - t0, EDIT_COUNT);
+    char *rope_flat = spda_rope_flatten(rope);
+
+    bool same = spda_len(plain) == spda_len(gap_view) && spda_len(plain) == spda_len(rope_flat)
+             && memcmp(plain, gap_view, spda_len(plain)) == 0
+             && memcmp(plain, rope_flat, spda_len(plain)) == 0;
+    printf("  results match: %s\n", same ? "yes" : "NO");
+
+    spda_destroy(rope_flat);
+    spda_rope_destroy(rope);
+    spda_gap_destroy(gb);
+    spda_destroy(plain);
+    spda_destroy(doc);
+    free(trace);
+    return same ? 0 : 1;
+}
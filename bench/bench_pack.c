@@ -0,0 +1,89 @@
+#include "bench.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../spda.h"
+#include "../spda_pack.h"
+
+/* Compression ratio and encode / decode throughput on realistic inputs */
+
+#define N (8u << 20)
+#define REPEAT 5
+
+static void run(const char *name, const void *array, SpdaPackType type, SpdaPackCodec codec)
+{
+    size_t raw = spda_len(array) * spda_stride(array);
+
+    double t0 = bench_now();
+    SpdaPacked *packed = NULL;
+    for (int r = 0; r < REPEAT; ++r) {
+        spda_packed_destroy(packed);
+        packed = spda_pack(array, type, codec);
+    }
+    double enc = (bench_now() - t0) / REPEAT;
+
+    /* Decode into a warmed up buffer so page faults are not measured */
+    void *out = spda_unpack(packed);
+    t0 = bench_now();
+    for (int r = 0; r < REPEAT; ++r) spda_unpack_range(packed, 0, packed->count, out);
+    double dec = (bench_now() - t0) / REPEAT;
+
+    /* Random access: decode single blocks at random positions */
+    uint64_t rng = 99;
+    char block[SPDA_PACK_BLOCK * sizeof(int64_t)];
+    size_t blocks = spda_len(packed->blocks), lookups = 100000;
+    t0 = bench_now();
+    for (size_t i = 0; i < lookups; ++i) spda_unpack_block(packed, bench_rand(&rng) % blocks, block);
+    double lookup = (bench_now() - t0) / (double)lookups;
+
+    bool ok = memcmp(out, array, raw) == 0;
+    printf("  %-28s ratio %6.2fx  encode %6.2f GB/s  decode %6.2f GB/s  block %6.0f ns  %s\n",
+           name, (double)raw / (double)spda_packed_bytes(packed),
+           (double)raw / enc * 1e-9, (double)raw / dec * 1e-9, lookup * 1e9, ok ? "" : "MISMATCH");
+
+    spda_destroy(out);
+    spda_packed_destroy(packed);
+}
+
+int main(void)
+{
+    printf("Columnar compression (%u elements)\n", N);
+    uint64_t rng = 1;
+
+    int32_t *sorted = spda_reserve(int32_t, N);
+    int32_t *random = spda_reserve(int32_t, N);
+    int64_t *timestamps = spda_reserve(int64_t, N);
+    double *metrics = spda_reserve(double, N);
+
+    int32_t id = 0;
+    int64_t ts = 1700000000000LL;
+    double level = 50.0;
+    for (size_t i = 0; i < N; ++i)
+    {
+        id += 1 + (int32_t)(bench_rand(&rng) % 16);                     // sorted ids with small gaps
+        ts += 1000 + (int64_t)(bench_rand(&rng) % 5) - 2;                // 1s ticks with jitter
+        level += ((double)(bench_rand(&rng) % 201) - 100.0) / 1000.0;    // slow random walk
+        sorted[i] = id;
+        random[i] = (int32_t)bench_rand(&rng);
+        timestamps[i] = ts;
+        metrics[i] = round(level * 100.0) / 100.0;                       // sensor precision
+    }
+    spda_set_length(sorted, N);
+    spda_set_length(random, N);
+    spda_set_length(timestamps, N);
+    spda_set_length(metrics, N);
+
+    run("sorted i32  DELTA_FOR", sorted, SPDA_PACK_I32, SPDA_PACK_DELTA_FOR);
+    run("sorted i32  VARINT", sorted, SPDA_PACK_I32, SPDA_PACK_VARINT);
+    run("random i32  DELTA_FOR", random, SPDA_PACK_I32, SPDA_PACK_DELTA_FOR);
+    run("random i32  VARINT", random, SPDA_PACK_I32, SPDA_PACK_VARINT);
+    run("timestamps i64 DELTA_FOR", timestamps, SPDA_PACK_I64, SPDA_PACK_DELTA_FOR);
+    run("timestamps i64 VARINT", timestamps, SPDA_PACK_I64, SPDA_PACK_VARINT);
+    run("metrics f64 XOR", metrics, SPDA_PACK_F64, SPDA_PACK_XOR);
+
+    spda_destroy(sorted);
+    spda_destroy(random);
+    spda_destroy(timestamps);
+    spda_destroy(metrics);
+    return 0;
+}
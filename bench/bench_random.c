@@ -0,0 +1,57 @@
+#include "bench.h"
+#include <stdlib.h>
+#include <string.h>
+#include "../spda.h"
+#include "../spda_random.h"
+
+/* rand() based spda_rand against the counter based batch generators */
+
+#define N 10000000
+#define WORKERS 8
+
+int main(void)
+{
+    printf("Random array generation (%d elements)\n", N);
+
+    srand(42);
+    int *legacy = spda_create(int);
+    double t0 = bench_now();
+    spda_rand(&legacy, N, 0, 1000);
+    bench_report("spda_rand (rand)", bench_now() - t0, N);
+
+    t0 = bench_now();
+    int *ints = spda_rand_int(N, 42, 0, 1000);
+    bench_report("spda_rand_int", bench_now() - t0, N);
+
+    t0 = bench_now();
+    double *doubles = spda_rand_double(N, 42, 0.0, 1.0);
+    bench_report("spda_rand_double", bench_now() - t0, N);
+
+    t0 = bench_now();
+    double *normal = spda_rand_normal(N, 42, 0.0, 1.0);
+    bench_report("spda_rand_normal", bench_now() - t0, N);
+
+    t0 = bench_now();
+    int *perm = spda_rand_permutation(N, 42);
+    bench_report("spda_rand_permutation", bench_now() - t0, N);
+
+    /* Workers filling disjoint ranges (run one after another here) reproduce the single fill */
+    int *split = spda_reserve(int, N);
+    t0 = bench_now();
+    for (size_t w = 0; w < WORKERS; ++w) {
+        size_t begin = N / WORKERS * w, end = w + 1 == WORKERS ? N : N / WORKERS * (w + 1);
+        spda_fill_int(split, begin, end - begin, 42, 0, 1000);
+    }
+    bench_report("spda_fill_int (8 ranges)", bench_now() - t0, N);
+    spda_set_length(split, N);
+    bool same = memcmp(split, ints, N * sizeof(int)) == 0;
+    printf("  split fill matches: %s\n", same ? "yes" : "NO");
+
+    spda_destroy(legacy);
+    spda_destroy(ints);
+    spda_destroy(doubles);
+    spda_destroy(normal);
+    spda_destroy(perm);
+    spda_destroy(split);
+    return same ? 0 : 1;
+}
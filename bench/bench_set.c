@@ -0,0 +1,107 @@
+#include "bench.h"
+#include <stdlib.h>
+#include <string.h>
+#include "../spda.h"
+#include "../spda_set.h"
+
+/*
+* Sorted ID sets at skewed size ratios: linear / galloping / SIMD passes against
+* the concatenate + spda_sort approach, plus a k-way merge.
+*/
+
+#define LARGE 2000000
+#define K 16
+
+static int comparInt(const void *a, const void *b)
+{
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+/* Strictly increasing ids with random gaps */
+static int *make_ids(size_t n, int gap, uint64_t *rng)
+{
+    int *ids = spda_reserve(int, n);
+    int id = 0;
+    for (size_t i = 0; i < n; ++i) {
+        id += 1 + (int)(bench_rand(rng) % (uint64_t)gap);
+        ids[i] = id;
+    }
+    spda_set_length(ids, n);
+    return ids;
+}
+
+static void ratio(size_t small_n, uint64_t *rng)
+{
+    int *big = make_ids(LARGE, 4, rng);
+    int *small = make_ids(small_n, 4 * LARGE / (int)small_n, rng);
+    char label[64];
+    printf(" 1:%zu (%zu vs %d)\n", (size_t)LARGE / small_n, small_n, LARGE);
+
+    double t0 = bench_now();
+    int *concat = spda_reserve(int, LARGE + small_n);
+    spda_append_items(concat, big, LARGE);
+    spda_append_items(concat, small, small_n);
+    spda_sort(concat, comparInt);
+    bench_report("  concat + spda_sort", bench_now() - t0, LARGE + small_n);
+
+    t0 = bench_now();
+    int *u = spda_union(big, small, comparInt);
+    bench_report("  spda_union", bench_now() - t0, LARGE + small_n);
+
+    t0 = bench_now();
+    int *in_generic = spda_intersect(small, big, comparInt);
+    bench_report("  spda_intersect", bench_now() - t0, LARGE + small_n);
+
+    t0 = bench_now();
+    int *in_int = spda_intersect_int(small, big);
+    snprintf(label, sizeof(label), "  spda_intersect_int (%s)",
+             LARGE / small_n >= 32 ? "gallop" : "simd");
+    bench_report(label, bench_now() - t0, LARGE + small_n);
+
+    t0 = bench_now();
+    int *diff = spda_difference(big, small, comparInt);
+    bench_report("  spda_difference", bench_now() - t0, LARGE + small_n);
+
+    if (spda_len(in_int) != spda_len(in_generic) || memcmp(in_int, in_generic, spda_len(in_int) * sizeof(int)) != 0)
+        printf("  intersection MISMATCH\n");
+
+    spda_destroy(concat);
+    spda_destroy(u);
+    spda_destroy(in_generic);
+    spda_destroy(in_int);
+    spda_destroy(diff);
+    spda_destroy(big);
+    spda_destroy(small);
+}
+
+int main(void)
+{
+    uint64_t rng = 3;
+    printf("Sorted set operations\n");
+    ratio(LARGE, &rng);
+    ratio(LARGE / 100, &rng);
+    ratio(LARGE / 10000, &rng);
+
+    printf(" k-way merge of %d runs (%d elements)\n", K, LARGE);
+    const void *runs[K];
+    for (int i = 0; i < K; ++i) runs[i] = make_ids(LARGE / K, 64, &rng);
+
+    double t0 = bench_now();
+    int *concat = spda_reserve(int, LARGE);
+    for (int i = 0; i < K; ++i) spda_append_items(concat, (void *)runs[i], spda_len(runs[i]));
+    spda_sort(concat, comparInt);
+    bench_report("  concat + spda_sort", bench_now() - t0, LARGE);
+
+    t0 = bench_now();
+    int *merged = spda_merge_k(spda_reserve(int, LARGE), runs, K, comparInt);
+    bench_report("  spda_merge_k", bench_now() - t0, LARGE);
+
+    bool same = spda_len(merged) == spda_len(concat) && memcmp(merged, concat, spda_len(merged) * sizeof(int)) == 0;
+    printf("  results match: %s\n", same ? "yes" : "NO");
+
+    for (int i = 0; i < K; ++i) spda_destroy((void *)runs[i]);
+    spda_destroy(concat);
+    spda_destroy(merged);
+    return same ? 0 : 1;
+}
@@ -0,0 +1,194 @@
+#include "bench.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../spda.h"
+#include "../spda_shm.h"
+
+/*
+* A producer process hands a stream of int64 batches to a consumer process:
+* pushing the bytes through a pipe into a reserved spda array on the other
+* side, against appending to a shared array the consumer reads in place.
+* Then one element ping-pong round trips over each channel.
+*/
+
+#define TOTAL (1 << 24)
+#define BATCH 16384
+#define ROUNDTRIPS 20000
+
+static const int64_t EXPECTED_SUM = (int64_t)TOTAL * (TOTAL - 1) / 2;
+
+static void write_all(int fd, const void *buf, size_t n)
+{
+    const char *p = buf;
+    while (n > 0) {
+        ssize_t w = write(fd, p, n);
+        if (w <= 0) _exit(2);
+        p += w;
+        n -= (size_t)w;
+    }
+}
+
+static void read_all(int fd, void *buf, size_t n)
+{
+    char *p = buf;
+    while (n > 0) {
+        ssize_t r = read(fd, p, n);
+        if (r <= 0) _exit(2);
+        p += r;
+        n -= (size_t)r;
+    }
+}
+
+static bool wait_child(pid_t pid)
+{
+    int status;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+static bool stream_pipe(const int64_t *batch)
+{
+    int fds[2];
+    if (pipe(fds) != 0) return false;
+
+    double t0 = bench_now();
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[1]);
+        int64_t *array = spda_reserve(int64_t, TOTAL);
+        read_all(fds[0], array, (size_t)TOTAL * sizeof(int64_t));
+        spda_set_length(array, TOTAL);
+        int64_t sum = 0;
+        for (size_t i = 0; i < spda_len(array); ++i) sum += array[i];
+        _exit(sum == EXPECTED_SUM ? 0 : 1);
+    }
+    close(fds[0]);
+    int64_t *chunk = malloc(BATCH * sizeof(int64_t));
+    for (int64_t base = 0; base < TOTAL; base += BATCH) {
+        for (int j = 0; j < BATCH; ++j) chunk[j] = batch[j] + base;
+        write_all(fds[1], chunk, BATCH * sizeof(int64_t));
+    }
+    close(fds[1]);
+    free(chunk);
+    bool ok = wait_child(pid);
+    double s = bench_now() - t0;
+    printf("  %-32s %10.3f ms  %10.1f MB/s\n", "pipe into spda array", s * 1e3, TOTAL * sizeof(int64_t) / s / 1e6);
+    return ok;
+}
+
+static bool stream_shm(SpdaShm *shm, const int64_t *batch, const char *label)
+{
+    spda_shm_truncate(shm, 0);
+    double t0 = bench_now();
+    pid_t pid = fork();
+    if (pid == 0) {
+        SpdaShm *reader = spda_shm_attach_fd(shm->fd, false);
+        const int64_t *view = spda_shm_data(reader);
+        int64_t sum = 0;
+        size_t seen = 0;
+        while (seen < TOTAL) {
+            size_t length = spda_shm_len(reader);
+            if (length == seen) { sched_yield(); continue; }
+            for (; seen < length; ++seen) sum += view[seen];
+        }
+        spda_shm_detach(reader);
+        _exit(sum == EXPECTED_SUM ? 0 : 1);
+    }
+    for (int64_t base = 0; base < TOTAL; base += BATCH) {
+        /* Produce straight into the shared array, then publish the batch */
+        spda_shm_reserve(shm, (size_t)base + BATCH);
+        int64_t *dst = (int64_t *)spda_shm_data(shm) + base;
+        for (int j = 0; j < BATCH; ++j) dst[j] = batch[j] + base;
+        spda_shm_publish(shm, (size_t)base + BATCH);
+    }
+    bool ok = wait_child(pid);
+    double s = bench_now() - t0;
+    printf("  %-32s %10.3f ms  %10.1f MB/s\n", label, s * 1e3, TOTAL * sizeof(int64_t) / s / 1e6);
+    return ok;
+}
+
+static bool pingpong_pipe(void)
+{
+    int ping[2], pong[2];
+    if (pipe(ping) != 0 || pipe(pong) != 0) return false;
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        int64_t token;
+        for (int i = 0; i < ROUNDTRIPS; ++i) {
+            read_all(ping[0], &token, sizeof(token));
+            write_all(pong[1], &token, sizeof(token));
+        }
+        _exit(0);
+    }
+    double t0 = bench_now();
+    bool ok = true;
+    for (int64_t i = 0; i < ROUNDTRIPS; ++i) {
+        int64_t token = i;
+        write_all(ping[1], &token, sizeof(token));
+        read_all(pong[0], &token, sizeof(token));
+        if (token != i) ok = false;
+    }
+    bench_report("pipe round trip", bench_now() - t0, ROUNDTRIPS);
+    close(ping[0]); close(ping[1]); close(pong[0]); close(pong[1]);
+    return wait_child(pid) && ok;
+}
+
+static bool pingpong_shm(void)
+{
+    /* The child becomes the writer of `pong`, so the parent keeps only a reader */
+    SpdaShm *ping = spda_shm_create(NULL, sizeof(int64_t), ROUNDTRIPS, 0);
+    SpdaShm *pong_owner = spda_shm_create(NULL, sizeof(int64_t), ROUNDTRIPS, 0);
+    if (ping == NULL || pong_owner == NULL) return false;
+    SpdaShm *pong = spda_shm_attach_fd(pong_owner->fd, false);
+    spda_shm_detach(pong_owner);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        SpdaShm *in = spda_shm_attach_fd(ping->fd, false);
+        SpdaShm *out = spda_shm_attach_fd(pong->fd, true);
+        if (in == NULL || out == NULL) _exit(1);
+        const int64_t *view = spda_shm_data(in);
+        for (size_t i = 0; i < ROUNDTRIPS; ++i) {
+            while (spda_shm_len(in) <= i) sched_yield();
+            spda_shm_append(out, &view[i]);
+        }
+        _exit(0);
+    }
+    double t0 = bench_now();
+    bool ok = true;
+    const int64_t *echo = spda_shm_data(pong);
+    for (int64_t i = 0; i < ROUNDTRIPS; ++i) {
+        spda_shm_append(ping, &i);
+        while (spda_shm_len(pong) <= (size_t)i) sched_yield();
+        if (echo[i] != i) ok = false;
+    }
+    bench_report("shared array round trip", bench_now() - t0, ROUNDTRIPS);
+    ok = wait_child(pid) && ok;
+    spda_shm_detach(ping);
+    spda_shm_detach(pong);
+    return ok;
+}
+
+int main(void)
+{
+    printf("Cross-process transfer (%d int64 in batches of %d, %d round trips)\n", TOTAL, BATCH, ROUNDTRIPS);
+    int64_t *batch = malloc(BATCH * sizeof(int64_t));
+    for (int j = 0; j < BATCH; ++j) batch[j] = j;
+
+    bool ok = stream_pipe(batch);
+    /* The second pass reuses pages the first one already backed */
+    SpdaShm *shm = spda_shm_create(NULL, sizeof(int64_t), BATCH, SPDA_SHM_DATA_OFFSET + (size_t)TOTAL * sizeof(int64_t));
+    ok = shm && stream_shm(shm, batch, "shared array (cold)") && ok;
+    ok = shm && stream_shm(shm, batch, "shared array (reused)") && ok;
+    spda_shm_detach(shm);
+    ok = pingpong_pipe() && ok;
+    ok = pingpong_shm() && ok;
+    printf("  results match: %s\n", ok ? "yes" : "NO");
+
+    free(batch);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+#include "bench.h"
+#include <stdlib.h>
+#include <string.h>
+#include <malloc.h>
+#include "../spda.h"
+#include "../spda_str.h"
+
+/*
+* One million short keys (many sharing a prefix, like paths or identifiers):
+* a spda array of strdup'd `char *` against SpdaStrs for footprint, loading,
+* sorting and lookup.
+*/
+
+#define N 1000000
+#define LOOKUPS 200000
+
+static int comparStr(const void *a, const void *b)
+{
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+/* Newline delimited keys: a handful of common prefixes plus a random tail */
+static char *make_text(uint64_t *rng, size_t *size)
+{
+    static const char *prefixes[] = {"", "user_", "src/lib/", "config.", "item"};
+    char *text = malloc((size_t)N * 32);
+    char *p = text;
+    for (size_t i = 0; i < N; ++i)
+    {
+        const char *prefix = prefixes[bench_rand(rng) % 5];
+        size_t plen = strlen(prefix);
+        memcpy(p, prefix, plen);
+        p += plen;
+        size_t tail = 3 + bench_rand(rng) % 10;
+        for (size_t j = 0; j < tail; ++j) *p++ = (char)('a' + bench_rand(rng) % 26);
+        *p++ = '\n';
+    }
+    *size = (size_t)(p - text);
+    return text;
+}
+
+int main(void)
+{
+    uint64_t rng = 11;
+    size_t size;
+    char *text = make_text(&rng, &size);
+    printf("String arrays (%d keys, %.1f MB of text)\n", N, size / 1e6);
+
+    /* char ** baseline: one malloc per string */
+    double t0 = bench_now();
+    char **ptrs = spda_create(char *);
+    size_t ptr_bytes = 0;
+    for (const char *line = text, *end = text + size; line < end;)
+    {
+        const char *nl = memchr(line, '\n', end - line);
+        char *s = malloc(nl - line + 1);
+        memcpy(s, line, nl - line);
+        s[nl - line] = '\0';
+        ptr_bytes += malloc_usable_size(s) + sizeof(size_t);     // plus the chunk header
+        spda_append(ptrs, s);
+        line = nl + 1;
+    }
+    bench_report("char ** load", bench_now() - t0, N);
+    ptr_bytes += FIELD_COUNT * sizeof(size_t) + spda_cap(ptrs) * sizeof(char *);
+
+    t0 = bench_now();
+    spda_sort(ptrs, comparStr);
+    bench_report("char ** sort", bench_now() - t0, N);
+
+    /* SpdaStrs: one buffer for every byte */
+    t0 = bench_now();
+    SpdaStrs *strs = spda_strs_create(false);
+    spda_strs_load(strs, text, size);
+    bench_report("SpdaStrs load", bench_now() - t0, N);
+
+    t0 = bench_now();
+    spda_strs_sort(strs);
+    bench_report("SpdaStrs prefix sort", bench_now() - t0, N);
+
+    t0 = bench_now();
+    size_t found = 0;
+    for (size_t i = 0; i < LOOKUPS; ++i) found += spda_strs_find(strs, ptrs[(i * 7919) % N]) != SPDA_STRS_NPOS;
+    bench_report("SpdaStrs binary search", bench_now() - t0, LOOKUPS);
+
+    /* Interned: the same keys through the hash table */
+    t0 = bench_now();
+    SpdaStrs *interned = spda_strs_create(true);
+    spda_strs_load(interned, text, size);
+    bench_report("SpdaStrs interned load", bench_now() - t0, N);
+
+    t0 = bench_now();
+    for (size_t i = 0; i < LOOKUPS; ++i) found += spda_strs_find(interned, ptrs[(i * 7919) % N]) != SPDA_STRS_NPOS;
+    bench_report("SpdaStrs interned find", bench_now() - t0, LOOKUPS);
+
+    printf("  footprint: char ** %.1f MB, SpdaStrs %.1f MB, interned %.1f MB (%zu unique)\n",
+           ptr_bytes / 1e6, spda_strs_bytes(strs) / 1e6, spda_strs_bytes(interned) / 1e6, spda_strs_len(interned));
+
+    bool same = spda_strs_len(strs) == spda_len(ptrs) && found == 2 * LOOKUPS;
+    for (size_t i = 0; same && i < spda_len(ptrs); ++i) {
+        if (strcmp(spda_strs_get(strs, i), ptrs[i]) != 0) same = false;
+    }
+    printf("  results match: %s\n", same ? "yes" : "NO");
+
+    for (size_t i = 0; i < spda_len(ptrs); ++i) free(ptrs[i]);
+    spda_destroy(ptrs);
+    spda_strs_destroy(strs);
+    spda_strs_destroy(interned);
+    free(text);
+    return same ? 0 : 1;
+}
@@ -0,0 +1,122 @@
+#include "bench.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "../spda.h"
+#include "../spda_text.h"
+
+/*
+* One million ints and doubles written out as text: spda_print with the
+* stock printers (stdout pointed at a temp file), fprintf with enough digits
+* to round trip, and a SpdaWriter on a FILE*. Then the doubles are read back
+* with spda_parse against a strtod loop.
+*/
+
+#define N 1000000
+
+/* Runs spda_print with stdout redirected to a temp file; returns the bytes written */
+static size_t print_to_file(void *array, void (*printer)(void *), double *seconds)
+{
+    fflush(stdout);
+    int saved = dup(STDOUT_FILENO);
+    FILE *file = tmpfile();
+    dup2(fileno(file), STDOUT_FILENO);
+
+    double t0 = bench_now();
+    spda_print(array, printer);
+    fflush(stdout);
+    *seconds = bench_now() - t0;
+
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+    fseek(file, 0, SEEK_END);
+    size_t bytes = (size_t)ftell(file);
+    fclose(file);
+    return bytes;
+}
+
+static void report(const char *name, double seconds, size_t bytes)
+{
+    printf("  %-32s %10.3f ms  %10.1f MB/s\n", name, seconds * 1e3, bytes / seconds / 1e6);
+}
+
+int main(void)
+{
+    uint64_t rng = 7;
+    int *ints = spda_reserve(int, N);
+    double *reals = spda_reserve(double, N);
+    for (size_t i = 0; i < N; ++i)
+    {
+        spda_append(ints, (int)bench_rand(&rng) - (1 << 30));
+        spda_append(reals, (double)bench_rand(&rng) / 1000.0 - 1e6);
+    }
+    printf("Text export (%d ints, %d doubles)\n", N, N);
+
+    double s;
+    size_t bytes = print_to_file(ints, printInt, &s);
+    report("spda_print int", s, bytes);
+    bytes = print_to_file(reals, printDouble, &s);
+    report("spda_print double (%lf)", s, bytes);
+
+    FILE *file = tmpfile();
+    double t0 = bench_now();
+    for (size_t i = 0; i < N; ++i) fprintf(file, "%.17g\n", reals[i]);
+    fflush(file);
+    s = bench_now() - t0;
+    report("fprintf double (%.17g)", s, (size_t)ftell(file));
+    fclose(file);
+
+    file = tmpfile();
+    t0 = bench_now();
+    SpdaWriter *w = spda_writer_file(file);
+    spda_write(w, ints, SPDA_TEXT_I32, SPDA_TEXT_CSV);
+    spda_writer_destroy(w);
+    fflush(file);
+    s = bench_now() - t0;
+    report("spda_write int", s, (size_t)ftell(file));
+    fclose(file);
+
+    file = tmpfile();
+    t0 = bench_now();
+    w = spda_writer_file(file);
+    spda_write(w, reals, SPDA_TEXT_F64, SPDA_TEXT_CSV);
+    spda_writer_destroy(w);
+    fflush(file);
+    s = bench_now() - t0;
+    report("spda_write double (shortest)", s, (size_t)ftell(file));
+    fclose(file);
+
+    /* Parse the shortest output back both ways */
+    w = spda_writer_memory();
+    spda_write(w, reals, SPDA_TEXT_F64, SPDA_TEXT_CSV);
+    char *text = spda_writer_release(w);
+    size_t size = spda_len(text);
+
+    t0 = bench_now();
+    double *naive = spda_create(double);
+    for (char *p = text, *stop; *p; p = stop)
+    {
+        double d = strtod(p, &stop);
+        if (stop == p) break;
+        spda_append(naive, d);
+    }
+    s = bench_now() - t0;
+    report("strtod + spda_append", s, size);
+
+    t0 = bench_now();
+    double *parsed = spda_parse(spda_create(double), text, size, SPDA_TEXT_F64);
+    s = bench_now() - t0;
+    report("spda_parse", s, size);
+
+    bool ok = spda_len(parsed) == N && spda_len(naive) == N
+           && memcmp(parsed, reals, N * sizeof(double)) == 0
+           && memcmp(naive, reals, N * sizeof(double)) == 0;
+    printf("  results match: %s\n", ok ? "yes" : "NO");
+
+    spda_destroy(parsed);
+    spda_destroy(naive);
+    spda_destroy(text);
+    spda_destroy(reals);
+    spda_destroy(ints);
+    return ok ? 0 : 1;
+}
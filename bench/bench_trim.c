@@ -0,0 +1,119 @@
+#include "bench.h"
+#include <stdlib.h>
+#include <unistd.h>
+#include "../spda.h"
+#include "../spda_trim.h"
+
+/*
+* Realloc counts for a push/pop workload oscillating around a capacity boundary
+* and RSS over time after a usage spike, with and without trim policies.
+*/
+
+#define OSCILLATIONS 20000
+#define SPIKE (16u << 20)           // 16M ints = 64 MiB
+
+static double rss_mib(void)
+{
+    FILE *f = fopen("/proc/self/statm", "r");
+    if (!f) return 0.0;
+    long pages = 0, resident = 0;
+    if (fscanf(f, "%ld %ld", &pages, &resident) != 2) resident = 0;
+    fclose(f);
+    return (double)resident * (double)sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0);
+}
+
+static void oscillate(const char *name, const SpdaTrimPolicy *policy, int base, int amplitude, int rounds)
+{
+    int *array = spda_create(int);
+    SpdaTrim *trim = policy ? spda_trim_attach(array, policy) : NULL;
+    size_t reallocs = 0;
+
+    /* Park the length at `base` and swing `amplitude` elements above it */
+    for (int i = 0; i < base; ++i) spda_append(array, i);
+    size_t cap = spda_cap(array);
+    double t0 = bench_now();
+    for (int i = 0; i < rounds; ++i)
+    {
+        for (int k = 0; k < amplitude; ++k) {
+            spda_append(array, k);
+            reallocs += spda_cap(array) != cap;
+            cap = spda_cap(array);
+        }
+        for (int k = 0; k < amplitude; ++k) {
+            spda_pop(array);
+            if (trim) spda_trim_note(trim);
+            reallocs += spda_cap(array) != cap;
+            cap = spda_cap(array);
+        }
+    }
+    double elapsed = bench_now() - t0;
+    printf("  %-24s %8zu reallocs %10.3f ms\n", name, reallocs, elapsed * 1e3);
+
+    spda_trim_detach(trim);
+    spda_destroy(array);
+}
+
+static void spike(const char *name, const SpdaTrimPolicy *policy)
+{
+    int *array = spda_create(int);
+    SpdaTrim *trim = policy ? spda_trim_attach(array, policy) : NULL;
+
+    for (size_t i = 0; i < SPIKE; ++i) spda_append(array, (int)i);
+    printf("  %-24s peak %7.1f MiB", name, rss_mib());
+
+    /* Drain back to a small working set over a few "ticks" */
+    for (int tick = 0; tick < 4; ++tick)
+    {
+        size_t target = SPIKE >> (4 * (tick + 1));
+        while (spda_len(array) > target) {
+            spda_pop(array);
+            if (trim) spda_trim_note(trim);
+        }
+        printf("  t%d %7.1f MiB", tick, rss_mib());
+    }
+    if (trim) {
+        spda_trim_all();
+        printf("  trim_all %7.1f MiB", rss_mib());
+    }
+    printf("\n");
+
+    spda_trim_detach(trim);
+    spda_destroy(array);
+}
+
+int main(void)
+{
+    SpdaTrimPolicy eager = SPDA_TRIM_DEFAULT_POLICY;
+    eager.shrink_below = 0.99;      // shrink as soon as there is slack ...
+    eager.shrink_to = 1.0;          // ... straight down to fit
+    eager.decay_ops = 0;
+
+    SpdaTrimPolicy hysteresis = SPDA_TRIM_DEFAULT_POLICY;
+
+    SpdaTrimPolicy madvised = SPDA_TRIM_DEFAULT_POLICY;
+    madvised.madvise_bytes = 1u << 20;
+
+    SpdaTrimPolicy slow_decay = SPDA_TRIM_DEFAULT_POLICY;
+    slow_decay.decay_ops = 1u << 20;
+
+    printf("Push/pop bouncing across a capacity boundary (%d rounds of 4096 +8)\n", OSCILLATIONS);
+    oscillate("no policy", NULL, 4096, 8, OSCILLATIONS);
+    oscillate("eager shrink-to-fit", &eager, 4096, 8, OSCILLATIONS);
+    oscillate("hysteresis (default)", &hysteresis, 4096, 8, OSCILLATIONS);
+
+    printf("Wide swings (%d rounds of 1024 +6144)\n", OSCILLATIONS / 10);
+    oscillate("no policy", NULL, 1024, 6144, OSCILLATIONS / 10);
+    oscillate("eager shrink-to-fit", &eager, 1024, 6144, OSCILLATIONS / 10);
+    oscillate("hysteresis (default)", &hysteresis, 1024, 6144, OSCILLATIONS / 10);
+    oscillate("hysteresis + slow decay", &slow_decay, 1024, 6144, OSCILLATIONS / 10);
+
+    printf("RSS after a %u element spike\n", SPIKE);
+    spike("no policy", NULL);
+    spike("hysteresis realloc", &hysteresis);
+    spike("hysteresis madvise", &madvised);
+
+    SpdaTrimStats stats = spda_trim_stats();
+    printf("  total: %zu shrinks, %zu madvises, %.1f MiB released\n",
+           stats.shrinks, stats.madvises, (double)stats.bytes_released / (1024.0 * 1024.0));
+    return 0;
+}
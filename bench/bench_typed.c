@@ -0,0 +1,77 @@
+#include "bench.h"
+#include <stdlib.h>
+#include "../spda.h"
+#include "../spda_typed.h"
+
+/* Typed (SPDA_DEFINE) code paths against the void* API on common operations */
+
+#define N 10000000
+#define INSERTS 20000
+
+static int comparInt(const void *a, const void *b)
+{
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+int main(void)
+{
+    printf("Typed vs void* API (%d ints)\n", N);
+    uint64_t rng = 7;
+    int *values = malloc(N * sizeof(int));
+    for (size_t i = 0; i < N; ++i) values[i] = (int)bench_rand(&rng);
+
+    /* append */
+    double t0 = bench_now();
+    int *untyped = spda_create(int);
+    for (size_t i = 0; i < N; ++i) spda_append(untyped, values[i]);
+    bench_report("append       (void*)", bench_now() - t0, N);
+
+    t0 = bench_now();
+    int *typed = spda_int_create();
+    for (size_t i = 0; i < N; ++i) typed = spda_int_append(typed, values[i]);
+    bench_report("append       (typed)", bench_now() - t0, N);
+
+    /* sum through the length accessor every iteration, like spda_foreach does */
+    volatile long long sink = 0;
+    t0 = bench_now();
+    long long sum = 0;
+    for (size_t i = 0; i < spda_len(untyped); ++i) sum += untyped[i];
+    sink += sum;
+    bench_report("iterate      (void*)", bench_now() - t0, N);
+
+    t0 = bench_now();
+    sum = 0;
+    for (size_t i = 0; i < spda_int_len(typed); ++i) sum += spda_int_get(typed, i);
+    sink += sum;
+    bench_report("iterate      (typed)", bench_now() - t0, N);
+
+    /* insert at the front half */
+    int *small_u = spda_create(int), *small_t = spda_int_create();
+    t0 = bench_now();
+    for (int i = 0; i < INSERTS; ++i) spda_insert(small_u, i / 2, i);
+    bench_report("insert       (void*)", bench_now() - t0, INSERTS);
+    t0 = bench_now();
+    for (int i = 0; i < INSERTS; ++i) small_t = spda_int_insert(small_t, (size_t)i / 2, i);
+    bench_report("insert       (typed)", bench_now() - t0, INSERTS);
+
+    /* sort */
+    t0 = bench_now();
+    spda_sort(untyped, comparInt);
+    bench_report("sort         (qsort)", bench_now() - t0, N);
+    t0 = bench_now();
+    spda_int_sort(typed);
+    bench_report("sort         (typed)", bench_now() - t0, N);
+
+    bool same = spda_len(untyped) == spda_len(typed);
+    for (size_t i = 0; same && i < spda_len(typed); ++i) same = untyped[i] == typed[i];
+    printf("  results match: %s\n", same ? "yes" : "NO");
+
+    spda_destroy(small_u);
+    spda_destroy(small_t);
+    spda_destroy(untyped);
+    spda_destroy(typed);
+    free(values);
+    (void)sink;
+    return same ? 0 : 1;
+}
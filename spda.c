@@ -3,12 +3,233 @@
 #include <stdio.h>
 #include "spda.h"
 
+#ifdef SPDA_DEBUG
+#if defined(__SANITIZE_ADDRESS__)
+#include <sanitizer/asan_interface.h>
+#endif
+#if defined(__has_include)
+#if __has_include(<valgrind/memcheck.h>)
+#include <valgrind/memcheck.h>
+#define SPDA_HAVE_VALGRIND
+#endif
+#endif
+#endif
+
+#define SPDA_HEADER_SIZE (FIELD_COUNT * sizeof(size_t))
+
+#ifdef SPDA_DEBUG
+#define SPDA_BLOCK_SIZE(cap, stride) (SPDA_HEADER_SIZE + (cap) * (stride) + SPDA_GUARD_SIZE)
+#else
+#define SPDA_BLOCK_SIZE(cap, stride) (SPDA_HEADER_SIZE + (cap) * (stride))
+#endif
+
+/* ------------------------------------------------------------------------- */
+/*                               DEBUG CHECKS                                */
+/* ------------------------------------------------------------------------- */
+
+#ifdef SPDA_DEBUG
+
+/* Tell the sanitizers a region must not be touched / may be touched again */
+static inline void _spda_poison(const void *addr, size_t size)
+{
+#if defined(__SANITIZE_ADDRESS__)
+    ASAN_POISON_MEMORY_REGION(addr, size);
+#endif
+#ifdef SPDA_HAVE_VALGRIND
+    VALGRIND_MAKE_MEM_NOACCESS(addr, size);
+#endif
+    (void)addr, (void)size;
+}
+
+static inline void _spda_unpoison(const void *addr, size_t size)
+{
+#if defined(__SANITIZE_ADDRESS__)
+    ASAN_UNPOISON_MEMORY_REGION(addr, size);
+#endif
+#ifdef SPDA_HAVE_VALGRIND
+    VALGRIND_MAKE_MEM_DEFINED(addr, size);
+#endif
+    (void)addr, (void)size;
+}
+
+static inline unsigned char *_spda_guard(size_t *header)
+{
+    return (unsigned char *)(header + FIELD_COUNT) + header[CAPACITY] * header[STRIDE];
+}
+
+static void _spda_guard_arm(size_t *header)
+{
+    unsigned char *guard = _spda_guard(header);
+    _spda_unpoison(guard, SPDA_GUARD_SIZE);
+    memset(guard, SPDA_GUARD_BYTE, SPDA_GUARD_SIZE);
+    _spda_poison(guard, SPDA_GUARD_SIZE);
+}
+
+static bool _spda_guard_intact(size_t *header, size_t capacity)
+{
+    unsigned char *guard = (unsigned char *)(header + FIELD_COUNT) + capacity * header[STRIDE];
+    bool intact = true;
+    _spda_unpoison(guard, SPDA_GUARD_SIZE);
+    for (size_t i = 0; i < SPDA_GUARD_SIZE; ++i) {
+        if (guard[i] != SPDA_GUARD_BYTE) intact = false;
+    }
+    _spda_poison(guard, SPDA_GUARD_SIZE);
+    return intact;
+}
+
+static bool _spda_debug_verify(const void *array, const char *file, int line, bool fatal)
+{
+    size_t *header = (size_t *)array - FIELD_COUNT;
+    const char *problem = NULL;
+    if (header[MAGIC] == SPDA_MAGIC_DEAD) problem = "Array used after it was resized away or destroyed (stale pointer)";
+    else if (header[MAGIC] != SPDA_MAGIC) problem = "Array header is corrupt or the pointer is not a spda array";
+    else if (header[STRIDE] == 0) problem = "Array header has a zero stride";
+    else {
+        /*
+        * A shared array (spda_shm.h) can grow under us and fill the old guard
+        * with elements; it publishes the new capacity first, so re-check there.
+        */
+        size_t capacity;
+        bool intact;
+        do {
+            capacity = __atomic_load_n(&header[CAPACITY], __ATOMIC_ACQUIRE);
+            intact = _spda_guard_intact(header, capacity);
+        } while (!intact && __atomic_load_n(&header[CAPACITY], __ATOMIC_ACQUIRE) != capacity);
+        if (!intact) problem = "Guard after capacity was overwritten (buffer overrun)";
+    }
+
+    if (problem == NULL) return true;
+    fprintf(stderr, "%s:%d [SPDA_DEBUG] - %s\n", file, line, problem);
+    if (fatal) abort();
+    return false;
+}
+
+/* Dead blocks stay allocated for a while so stale pointers keep reading SPDA_MAGIC_DEAD */
+static struct {
+    size_t *block;
+    size_t size;
+} _spda_quarantine[SPDA_QUARANTINE];
+static size_t _spda_quarantine_next;
+
+static void _spda_retire(size_t *header)
+{
+    size_t size = SPDA_BLOCK_SIZE(header[CAPACITY], header[STRIDE]);
+    header[MAGIC] = SPDA_MAGIC_DEAD;
+    memset(header + FIELD_COUNT, SPDA_POISON_BYTE, header[CAPACITY] * header[STRIDE]);
+    _spda_poison(header, size);
+
+    size_t slot = _spda_quarantine_next;
+    _spda_quarantine_next = (slot + 1) % SPDA_QUARANTINE;
+    if (_spda_quarantine[slot].block) {
+        _spda_unpoison(_spda_quarantine[slot].block, _spda_quarantine[slot].size);
+        free(_spda_quarantine[slot].block);
+    }
+    _spda_quarantine[slot].block = header;
+    _spda_quarantine[slot].size = size;
+}
+
+/* Popped and removed slots read back as poison, and as undefined under Valgrind */
+static void _spda_vacate(void *array, size_t from, size_t count)
+{
+    size_t stride = ((size_t *)array - FIELD_COUNT)[STRIDE];
+    memset((char *)array + from * stride, SPDA_POISON_BYTE, count * stride);
+#ifdef SPDA_HAVE_VALGRIND
+    VALGRIND_MAKE_MEM_UNDEFINED((char *)array + from * stride, count * stride);
+#endif
+}
+
+size_t _spda_check_index(const void *array, size_t idx, const char *file, int line)
+{
+    if (!array) {
+        fprintf(stderr, "%s:%d [SPDA_DEBUG] - Indexing a NULL array\n", file, line);
+        abort();
+    }
+    _spda_debug_verify(array, file, line, true);
+
+    size_t length = ((const size_t *)array - FIELD_COUNT)[LENGTH];
+    if (idx >= length) {
+        fprintf(stderr, "%s:%d [INDEX_OUT_OF_BOUNDS] - Index %zu for an array of length %zu\n", file, line, idx, length);
+        abort();
+    }
+    return idx;
+}
+
+static inline bool _spda_is_valid(const void *array) {
+    if (!array) return false;
+    return _spda_debug_verify(array, __FILE__, __LINE__, true);
+}
+
+/* Hooks for the inline SPDA_DEFINE functions, which read the header directly */
+void _spda_debug_check(const void *array, const char *file, int line)
+{
+    if (!array) {
+        fprintf(stderr, "%s:%d [SPDA_DEBUG] - Using a NULL array\n", file, line);
+        abort();
+    }
+    _spda_debug_verify(array, file, line, true);
+}
+
+void _spda_debug_vacate(void *array, size_t from, size_t count)
+{
+    _spda_vacate(array, from, count);
+}
+
+#else
+
+#define _spda_vacate(array, from, count) ((void)0)
+
 static inline bool _spda_is_valid(const void *array) {
     if (!array) return false;
     size_t *header = (size_t *)array - FIELD_COUNT;
     return header && header[STRIDE] > 0;
 }
 
+#endif // SPDA_DEBUG
+
+bool spda_check(const void *array)
+{
+    if (!array) {
+        raise("INVALID_SOURCE", "Source array cannot be NULL");
+        return false;
+    }
+#ifdef SPDA_DEBUG
+    return _spda_debug_verify(array, __FILE__, __LINE__, false);
+#else
+    return _spda_is_valid(array);
+#endif
+}
+
+size_t spda_generation(const void *array)
+{
+#ifdef SPDA_DEBUG
+    if (!_spda_is_valid(array)) return 0;
+    return ((const size_t *)array - FIELD_COUNT)[GENERATION];
+#else
+    (void)array;
+    return 0;
+#endif
+}
+
+/* Resize the whole block; debug builds always move it and retire the old one */
+static size_t *_spda_block_resize(size_t *header, size_t new_cap)
+{
+#ifdef SPDA_DEBUG
+    size_t *new_header = malloc(SPDA_BLOCK_SIZE(new_cap, header[STRIDE]));
+    if (new_header == NULL) return NULL;
+
+    size_t old_bytes = header[CAPACITY] * header[STRIDE];
+    size_t new_bytes = new_cap * header[STRIDE];
+    memcpy(new_header, header, SPDA_HEADER_SIZE + (old_bytes < new_bytes ? old_bytes : new_bytes));
+    new_header[CAPACITY] = new_cap;
+    new_header[GENERATION] = header[GENERATION] + 1;
+    _spda_guard_arm(new_header);
+    _spda_retire(header);
+    return new_header;
+#else
+    return realloc(header, SPDA_BLOCK_SIZE(new_cap, header[STRIDE]));
+#endif
+}
+
 extern inline size_t spda_len(const void *array)  {
     return _spda_field_get((void *)array, LENGTH);
 }
@@ -29,9 +250,7 @@ void *_spda_create(size_t cap, size_t stride)
         return NULL;
     }
     
-    size_t header_size = FIELD_COUNT * sizeof(size_t);
-    size_t array_size = cap * stride;
-    size_t *array = (size_t *) malloc(header_size + array_size);
+    size_t *array = (size_t *) malloc(SPDA_BLOCK_SIZE(cap, stride));
 
     if (!array) {
         raise("MEM_ALLOCATION", "Failed memory allocation for dynamic array.");
@@ -41,6 +260,11 @@ void *_spda_create(size_t cap, size_t stride)
     array[CAPACITY] = cap;
     array[LENGTH] = 0;
     array[STRIDE] = stride;
+#ifdef SPDA_DEBUG
+    array[GENERATION] = 0;
+    array[MAGIC] = SPDA_MAGIC;
+    _spda_guard_arm(array);
+#endif
     return (void *)((size_t *)array + FIELD_COUNT);
 }
 
@@ -48,7 +272,11 @@ void _spda_destroy(void *array)
 {   
     if (!_spda_is_valid(array)) return;
     size_t* header = (size_t *)array - FIELD_COUNT;
+#ifdef SPDA_DEBUG
+    _spda_retire(header);
+#else
     free(header);
+#endif
 }
 
 size_t _spda_field_get(void *array, size_t field)
@@ -71,14 +299,13 @@ void *_spda_resize_def(void *array)
 
     size_t *header = (size_t *)array - FIELD_COUNT;
     size_t new_cap = (size_t) header[CAPACITY] * SPDA_GROWTH_FACTOR;      
-    size_t new_size = (FIELD_COUNT * sizeof(size_t)) + (new_cap * header[STRIDE]);
     if (header == NULL) 
     {
         raise("MEM_ALLOCATION", "Array header was not allocated properly."); 
         return NULL;
     }
 
-    size_t *new_header = realloc(header, new_size);
+    size_t *new_header = _spda_block_resize(header, new_cap);
     if (new_header == NULL)
     {
         raise("MEM_ALLOCATION", "Failed to reallocate the header and the array.");
@@ -96,14 +323,13 @@ void *_spda_resize(void *array, size_t size)
 
     size_t *header = (size_t *)array - FIELD_COUNT;
     size_t new_cap = size;         
-    size_t new_size = (FIELD_COUNT * sizeof(size_t)) + (new_cap * header[STRIDE]);
     if (header == NULL) 
     {
         raise("MEM_ALLOCATION", "Array header was not allocated properly."); 
         return NULL;
     }
 
-    void *new_header = realloc(header, new_size);
+    void *new_header = _spda_block_resize(header, new_cap);
     if (new_header == NULL)
     {
         raise("MEM_ALLOCATION", "Failed to reallocate the array header.");
@@ -174,6 +400,7 @@ void _spda_pop(void *array)
         return;
     }
     _spda_field_set(array, LENGTH, length - 1);
+    _spda_vacate(array, length - 1, 1);
 }
 
 bool _spda_pop_ret(void *array, void *dest) 
@@ -196,6 +423,7 @@ bool _spda_pop_ret(void *array, void *dest)
     } 
 
     _spda_field_set(array, LENGTH, length - 1);
+    _spda_vacate(array, length - 1, 1);
     return true;
 }
 
@@ -228,11 +456,14 @@ void *_spda_remove(void *array, int idx)
     }
     memmove((char *)array + idx * stride, (char *)array + (idx + 1) * stride, (length - idx - 1) * stride);
     _spda_field_set(array, LENGTH, length - 1);
+    _spda_vacate(array, length - 1, 1);
     return array;
 }
 
 void *_spda_remove_ret(void *array, int idx, void *dest)
 {
+    /* spda_stride reports an invalid array as (size_t)-1, which must never reach memcpy */
+    if (!_spda_is_valid(array)) return array;
     size_t length = spda_len(array);
     size_t stride = spda_stride(array);
     if (idx < 0 || (size_t)idx >= length) {
@@ -242,6 +473,7 @@ void *_spda_remove_ret(void *array, int idx, void *dest)
     memcpy(dest, (char *)array + idx * stride, stride);
     memmove((char *)array + idx * stride, (char *)array + (idx + 1) * stride, (length - idx - 1) * stride);
     _spda_field_set(array, LENGTH, length - 1);
+    _spda_vacate(array, length - 1, 1);
     return array;
 }
 
@@ -277,8 +509,6 @@ void *spda_copy(void *src)
     size_t capacity = spda_cap(src);
     size_t length = spda_len(src);
     size_t stride = spda_stride(src);
-    size_t arr_size = capacity * stride;
-    size_t header_size = sizeof(size_t) * FIELD_COUNT;
     
     void *_dst = _spda_create(capacity, stride);
     if (_dst == NULL)
@@ -286,9 +516,9 @@ void *spda_copy(void *src)
         raise("MEM_ALLOCATION", "Failed to allocate memory for the new array");
         return NULL;
     }
-    memcpy(_dst, (size_t *)src - FIELD_COUNT, arr_size + header_size);
+    memcpy(_dst, src, length * stride);
     _spda_field_set(_dst, LENGTH, length);
-    return (void *)((size_t *)_dst + FIELD_COUNT);
+    return _dst;
 }
 
 void spda_sort(void *array, int (*compar)(const void *, const void *))
@@ -318,9 +548,12 @@ void spda_print_metadata(void *array)
 
 void spda_print(void *array, void (*spdaElemPrinter)(void *elem))
 {   
-    for (size_t i = 0; i < spda_len(array); ++i) 
+    /* Printers cannot resize the array, so read the header once */
+    size_t length = spda_len(array);
+    size_t stride = spda_stride(array);
+    char *p = (char *)array;
+    for (size_t i = 0; i < length; ++i, p += stride) 
     {   
-        void *p = ((char *)array + i * spda_stride(array));
         spdaElemPrinter(p);
     }
     printf("\n");
@@ -365,9 +598,19 @@ float randfloat(float min, float max)
     return (min + f * (max - min));
 }
 
-/* Generating random arrays */
+/* Generating random arrays (see spda_random.h for the seedable batch generators) */
+static void _spda_rand_reserve(void **array, size_t n)
+{
+    /* Grow once up front instead of doubling through every append */
+    size_t need = spda_len(*array) + n;
+    if (need <= spda_cap(*array)) return;
+    void *new_array = _spda_resize(*array, need);
+    if (new_array != NULL) *array = new_array;
+}
+
 void spda_rand(int **array, size_t n, int min, int max)
 {   
+    _spda_rand_reserve((void **)array, n);
     for (size_t i = 0; i < n; ++i)
     {   
         int random_value = randint(min, max);
@@ -377,6 +620,7 @@ void spda_rand(int **array, size_t n, int min, int max)
 
 void spda_randf(float **array, size_t n, float min, float max)
 {   
+    _spda_rand_reserve((void **)array, n);
     for (size_t i = 0; i < n; ++i)  
     {   
         float random_value = randfloat(min, max);
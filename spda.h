@@ -27,12 +27,22 @@
 *  +---------------------------------------+---------------------------------------+
 *                                          ^
 *                                      array pointer 
+*
+*  Compiled with -DSPDA_DEBUG the header grows a generation counter and a
+*  magic word right before the elements, and a guard zone follows capacity:
+*  +---------------------------------------------+------------+-------------+
+*  | capacity | length | stride | gen  | magic   |  elements  |  guard (16) |
+*  +---------------------------------------------+------------+-------------+
 */
 
 typedef enum {
     CAPACITY,               // capacity 
     LENGTH,                 // length 
     STRIDE,                 // stride
+#ifdef SPDA_DEBUG
+    GENERATION,             // number of times the array was moved by a resize
+    MAGIC,                  // SPDA_MAGIC while live, SPDA_MAGIC_DEAD once resized away or destroyed
+#endif
     FIELD_COUNT             // number of fields
 } SPDA_FIELD;
 
@@ -52,7 +62,41 @@ typedef enum {
 /* Core Operations */
 void *_spda_create(size_t cap, size_t stride);
 void _spda_destroy(void *array);
-static inline bool _spda_is_valid(const void *array);
+
+/*
+** Debug Build **
+* -DSPDA_DEBUG turns on checks meant to catch stale aliases (a pointer kept
+* across an append that moved the array) and overruns:
+*   - every access, including the inline SPDA_DEFINE functions, verifies the
+*     magic word and the guard zone after capacity and aborts with a report
+*     on the first mismatch;
+*   - resizes always move the array, and the old block (like a destroyed one)
+*     is marked dead, filled with SPDA_POISON_BYTE and held in a small
+*     quarantine so later use through the stale pointer is caught;
+*   - popped and removed slots are poisoned, and under Valgrind marked
+*     undefined; AddressSanitizer builds also poison the guard zone and
+*     quarantined blocks so the first bad access is reported in place.
+* Without SPDA_DEBUG none of this exists: the header stays three fields and
+* spda_at is plain indexing.
+*/
+#define SPDA_MAGIC          0x5350DA7Au
+#define SPDA_MAGIC_DEAD     0xDEADDA7Au
+#define SPDA_GUARD_SIZE     16
+#define SPDA_GUARD_BYTE     0xFD
+#define SPDA_POISON_BYTE    0xDD
+#define SPDA_QUARANTINE     64
+
+bool spda_check(const void *array);             // false (with a report) if the array is corrupt or stale
+size_t spda_generation(const void *array);      // moves so far, always 0 without SPDA_DEBUG
+
+#ifdef SPDA_DEBUG
+size_t _spda_check_index(const void *array, size_t idx, const char *file, int line);
+void _spda_debug_check(const void *array, const char *file, int line);
+void _spda_debug_vacate(void *array, size_t from, size_t count);
+#define spda_at(array, idx) (array)[_spda_check_index((array), (idx), __FILE__, __LINE__)]
+#else
+#define spda_at(array, idx) (array)[(idx)]
+#endif
 
 /* Field Operations */
 size_t _spda_field_get(void *array, size_t field);
@@ -0,0 +1,478 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include "spda_edit.h"
+
+/* ------------------------------------------------------------------------- */
+/*                                 GAP BUFFER                                */
+/* ------------------------------------------------------------------------- */
+
+static inline char *_spda_gap_slot(const SpdaGap *gb, size_t slot)
+{
+    return (char *)gb->data + slot * spda_stride(gb->data);
+}
+
+SpdaGap *_spda_gap_create(size_t cap, size_t stride)
+{
+    void *data = _spda_create(cap, stride);
+    if (data == NULL) return NULL;
+
+    SpdaGap *gb = spda_gap_from(data);
+    if (gb == NULL) _spda_destroy(data);
+    return gb;
+}
+
+SpdaGap *spda_gap_from(void *array)
+{
+    if (!array) {
+        raise("INVALID_SOURCE", "Source array cannot be NULL");
+        return NULL;
+    }
+
+    SpdaGap *gb = malloc(sizeof(SpdaGap));
+    if (gb == NULL) {
+        raise("MEM_ALLOCATION", "Failed to allocate gap buffer");
+        return NULL;
+    }
+
+    /* An ordinary spda array is a gap buffer with the gap parked at the end */
+    gb->data = array;
+    gb->gap_start = spda_len(array);
+    gb->gap_end = spda_cap(array);
+    return gb;
+}
+
+void spda_gap_destroy(SpdaGap *gb)
+{
+    if (!gb) return;
+    _spda_destroy(gb->data);
+    free(gb);
+}
+
+void *spda_gap_release(SpdaGap *gb)
+{
+    if (!gb) return NULL;
+    void *array = spda_gap_view(gb);
+    free(gb);
+    return array;
+}
+
+size_t spda_gap_len(const SpdaGap *gb)
+{
+    return spda_len(gb->data);
+}
+
+void spda_gap_move(SpdaGap *gb, size_t pos)
+{
+    size_t length = spda_gap_len(gb);
+    if (pos > length) pos = length;
+
+    size_t stride = spda_stride(gb->data);
+    if (pos < gb->gap_start)
+    {
+        /* Cursor moves left: the items in [pos, gap_start) hop over the gap */
+        size_t n = gb->gap_start - pos;
+        memmove(_spda_gap_slot(gb, gb->gap_end - n), _spda_gap_slot(gb, pos), n * stride);
+        gb->gap_start -= n;
+        gb->gap_end -= n;
+    }
+    else if (pos > gb->gap_start)
+    {
+        /* Cursor moves right: the first (pos - gap_start) back items hop over the gap */
+        size_t n = pos - gb->gap_start;
+        memmove(_spda_gap_slot(gb, gb->gap_start), _spda_gap_slot(gb, gb->gap_end), n * stride);
+        gb->gap_start += n;
+        gb->gap_end += n;
+    }
+}
+
+static bool _spda_gap_grow(SpdaGap *gb, size_t need)
+{
+    size_t cap = spda_cap(gb->data);
+    size_t back = cap - gb->gap_end;
+    size_t new_cap = cap;
+    while (new_cap - spda_gap_len(gb) < need) new_cap *= SPDA_GROWTH_FACTOR;
+
+    void *new_data = _spda_resize(gb->data, new_cap);
+    if (new_data == NULL) {
+        raise("MEM_ALLOCATION", "Failed to grow gap buffer");
+        return false;
+    }
+    gb->data = new_data;
+
+    /* Keep the back items flush against the (new) end of the buffer */
+    size_t stride = spda_stride(gb->data);
+    memmove(_spda_gap_slot(gb, new_cap - back), _spda_gap_slot(gb, gb->gap_end), back * stride);
+    gb->gap_end = new_cap - back;
+    return true;
+}
+
+bool spda_gap_insert(SpdaGap *gb, size_t pos, const void *value)
+{
+    return spda_gap_insert_many(gb, pos, value, 1);
+}
+
+bool spda_gap_insert_many(SpdaGap *gb, size_t pos, const void *items, size_t count)
+{
+    if (!gb || !items) {
+        raise("INVALID_ARGUMENT", "Invalid gap buffer or items");
+        return false;
+    }
+
+    size_t length = spda_gap_len(gb);
+    if (pos > length) {
+        raise("INDEX_OUT_OF_BOUNDS", "Index out of bounds for gap insert");
+        return false;
+    }
+
+    spda_gap_move(gb, pos);
+    if (gb->gap_end - gb->gap_start < count && !_spda_gap_grow(gb, count)) return false;
+
+    memcpy(_spda_gap_slot(gb, gb->gap_start), items, count * spda_stride(gb->data));
+    gb->gap_start += count;
+    _spda_field_set(gb->data, LENGTH, length + count);
+    return true;
+}
+
+bool spda_gap_remove(SpdaGap *gb, size_t pos, size_t count)
+{
+    size_t length = spda_gap_len(gb);
+    if (pos > length || count > length - pos) {
+        raise("INDEX_OUT_OF_BOUNDS", "Index out of bounds for gap remove");
+        return false;
+    }
+
+    /* Removing is just widening the gap over the doomed items */
+    spda_gap_move(gb, pos);
+    gb->gap_end += count;
+    _spda_field_set(gb->data, LENGTH, length - count);
+    return true;
+}
+
+void *spda_gap_at(const SpdaGap *gb, size_t idx)
+{
+    if (idx >= spda_gap_len(gb)) {
+        raise("INDEX_OUT_OF_BOUNDS", "Index out of bounds for gap access");
+        return NULL;
+    }
+    if (idx >= gb->gap_start) idx += gb->gap_end - gb->gap_start;
+    return _spda_gap_slot(gb, idx);
+}
+
+void *spda_gap_view(SpdaGap *gb)
+{
+    spda_gap_move(gb, spda_gap_len(gb));
+    return gb->data;
+}
+
+/* ------------------------------------------------------------------------- */
+/*                                CHUNKED ROPE                               */
+/* ------------------------------------------------------------------------- */
+
+struct SpdaRopeNode {
+    SpdaRopeNode *left;
+    SpdaRopeNode *right;
+    uint32_t prio;          // max-heap priority
+    size_t size;            // elements in this subtree
+    void *chunk;            // spda array of at most SPDA_ROPE_CHUNK elements
+};
+
+static inline size_t _rope_size(const SpdaRopeNode *node)
+{
+    return node ? node->size : 0;
+}
+
+static inline void _rope_update(SpdaRopeNode *node)
+{
+    node->size = _rope_size(node->left) + spda_len(node->chunk) + _rope_size(node->right);
+}
+
+static uint32_t _rope_prio(SpdaRope *rope)
+{
+    /* xorshift64* */
+    rope->seed ^= rope->seed >> 12;
+    rope->seed ^= rope->seed << 25;
+    rope->seed ^= rope->seed >> 27;
+    return (uint32_t)((rope->seed * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+static SpdaRopeNode *_rope_node_create(SpdaRope *rope)
+{
+    SpdaRopeNode *node = malloc(sizeof(SpdaRopeNode));
+    if (node == NULL) {
+        raise("MEM_ALLOCATION", "Failed to allocate rope node");
+        return NULL;
+    }
+    node->chunk = _spda_create(SPDA_ROPE_CHUNK, rope->stride);
+    if (node->chunk == NULL) {
+        free(node);
+        return NULL;
+    }
+    node->left = node->right = NULL;
+    node->prio = _rope_prio(rope);
+    node->size = 0;
+    return node;
+}
+
+static void _rope_node_destroy(SpdaRopeNode *node)
+{
+    if (!node) return;
+    _rope_node_destroy(node->left);
+    _rope_node_destroy(node->right);
+    _spda_destroy(node->chunk);
+    free(node);
+}
+
+static SpdaRopeNode *_rope_merge(SpdaRopeNode *a, SpdaRopeNode *b)
+{
+    if (!a) return b;
+    if (!b) return a;
+    if (a->prio > b->prio) {
+        a->right = _rope_merge(a->right, b);
+        _rope_update(a);
+        return a;
+    }
+    b->left = _rope_merge(a, b->left);
+    _rope_update(b);
+    return b;
+}
+
+/* Split off the first `k` elements. `k` must fall on a chunk boundary. */
+static void _rope_split(SpdaRopeNode *node, size_t k, SpdaRopeNode **l, SpdaRopeNode **r)
+{
+    if (!node) {
+        *l = *r = NULL;
+        return;
+    }
+    size_t lsize = _rope_size(node->left);
+    if (k <= lsize) {
+        _rope_split(node->left, k, l, &node->left);
+        _rope_update(node);
+        *r = node;
+    } else {
+        _rope_split(node->right, k - lsize - spda_len(node->chunk), &node->right, r);
+        _rope_update(node);
+        *l = node;
+    }
+}
+
+/*
+* Find the chunk holding position `idx`. With `inclusive` set, a position equal
+* to a chunk's length resolves to that chunk (insert at its end).
+*/
+static SpdaRopeNode *_rope_locate(const SpdaRope *rope, size_t idx, bool inclusive,
+                                  size_t *offset, size_t *chunk_start)
+{
+    SpdaRopeNode *node = rope->root;
+    size_t base = 0;
+    while (node) {
+        size_t lsize = _rope_size(node->left);
+        size_t clen = spda_len(node->chunk);
+        if (idx < lsize) {
+            node = node->left;
+            continue;
+        }
+        idx -= lsize;
+        base += lsize;
+        if (idx < clen || (inclusive && idx == clen)) {
+            *offset = idx;
+            *chunk_start = base;
+            return node;
+        }
+        idx -= clen;
+        base += clen;
+        node = node->right;
+    }
+    return NULL;
+}
+
+/* Re-walk the path to the located chunk adjusting cached subtree sizes */
+static void _rope_adjust(SpdaRope *rope, size_t idx, bool inclusive, int delta)
+{
+    SpdaRopeNode *node = rope->root;
+    while (node) {
+        size_t lsize = _rope_size(node->left);
+        size_t clen = spda_len(node->chunk);
+        node->size += delta;
+        if (idx < lsize) {
+            node = node->left;
+            continue;
+        }
+        idx -= lsize;
+        if (idx < clen || (inclusive && idx == clen)) return;
+        idx -= clen;
+        node = node->right;
+    }
+}
+
+SpdaRope *_spda_rope_create(size_t stride)
+{
+    if (stride == 0) {
+        raise("INVALID_ARGUMENT", "Stride (size of datatype) cannot be zero");
+        return NULL;
+    }
+
+    SpdaRope *rope = malloc(sizeof(SpdaRope));
+    if (rope == NULL) {
+        raise("MEM_ALLOCATION", "Failed to allocate rope");
+        return NULL;
+    }
+    rope->root = NULL;
+    rope->stride = stride;
+    rope->seed = 0x9E3779B97F4A7C15ULL;
+    return rope;
+}
+
+SpdaRope *spda_rope_from(const void *array)
+{
+    if (!array) {
+        raise("INVALID_SOURCE", "Source array cannot be NULL");
+        return NULL;
+    }
+
+    size_t length = spda_len(array);
+    size_t stride = spda_stride(array);
+    SpdaRope *rope = _spda_rope_create(stride);
+    if (rope == NULL) return NULL;
+
+    /* Fill chunks half way so that early inserts do not immediately split them */
+    const size_t fill = SPDA_ROPE_CHUNK / 2;
+    for (size_t i = 0; i < length; i += fill)
+    {
+        size_t n = length - i < fill ? length - i : fill;
+        SpdaRopeNode *node = _rope_node_create(rope);
+        if (node == NULL) {
+            spda_rope_destroy(rope);
+            return NULL;
+        }
+        memcpy(node->chunk, (const char *)array + i * stride, n * stride);
+        _spda_field_set(node->chunk, LENGTH, n);
+        _rope_update(node);
+        rope->root = _rope_merge(rope->root, node);
+    }
+    return rope;
+}
+
+void spda_rope_destroy(SpdaRope *rope)
+{
+    if (!rope) return;
+    _rope_node_destroy(rope->root);
+    free(rope);
+}
+
+size_t spda_rope_len(const SpdaRope *rope)
+{
+    return _rope_size(rope->root);
+}
+
+bool spda_rope_insert(SpdaRope *rope, size_t idx, const void *value)
+{
+    if (!rope || !value) {
+        raise("INVALID_ARGUMENT", "Invalid rope or value");
+        return false;
+    }
+    if (idx > spda_rope_len(rope)) {
+        raise("INDEX_OUT_OF_BOUNDS", "Index out of bounds for rope insert");
+        return false;
+    }
+
+    if (rope->root == NULL) {
+        rope->root = _rope_node_create(rope);
+        if (rope->root == NULL) return false;
+    }
+
+    size_t offset, start;
+    SpdaRopeNode *node = _rope_locate(rope, idx, true, &offset, &start);
+    size_t clen = spda_len(node->chunk);
+
+    if (clen < SPDA_ROPE_CHUNK)
+    {
+        /* Fast path: room in the chunk, only the sizes along the path change */
+        _spda_insert(node->chunk, (int)offset, value);
+        _rope_adjust(rope, idx, true, +1);
+        return true;
+    }
+
+    /* Slow path: detach the full chunk, split it in half and splice both back */
+    SpdaRopeNode *sibling = _rope_node_create(rope);
+    if (sibling == NULL) return false;
+
+    SpdaRopeNode *l, *m, *r;
+    _rope_split(rope->root, start, &l, &m);
+    _rope_split(m, clen, &m, &r);
+
+    size_t half = clen / 2;
+    memcpy(sibling->chunk, (char *)m->chunk + half * rope->stride, (clen - half) * rope->stride);
+    _spda_field_set(sibling->chunk, LENGTH, clen - half);
+    _spda_field_set(m->chunk, LENGTH, half);
+
+    if (offset <= half) _spda_insert(m->chunk, (int)offset, value);
+    else                _spda_insert(sibling->chunk, (int)(offset - half), value);
+    _rope_update(m);
+    _rope_update(sibling);
+
+    rope->root = _rope_merge(_rope_merge(l, m), _rope_merge(sibling, r));
+    return true;
+}
+
+bool spda_rope_remove(SpdaRope *rope, size_t idx)
+{
+    if (!rope || idx >= spda_rope_len(rope)) {
+        raise("INDEX_OUT_OF_BOUNDS", "Index out of bounds for rope remove");
+        return false;
+    }
+
+    size_t offset, start;
+    SpdaRopeNode *node = _rope_locate(rope, idx, false, &offset, &start);
+
+    if (spda_len(node->chunk) > 1)
+    {
+        _rope_adjust(rope, idx, false, -1);
+        _spda_remove(node->chunk, (int)offset);
+        return true;
+    }
+
+    /* Last element of the chunk: drop the whole node */
+    SpdaRopeNode *l, *m, *r;
+    _rope_split(rope->root, start, &l, &m);
+    _rope_split(m, 1, &m, &r);
+    _rope_node_destroy(m);
+    rope->root = _rope_merge(l, r);
+    return true;
+}
+
+void *spda_rope_at(const SpdaRope *rope, size_t idx)
+{
+    size_t offset, start;
+    SpdaRopeNode *node = rope ? _rope_locate(rope, idx, false, &offset, &start) : NULL;
+    if (node == NULL) {
+        raise("INDEX_OUT_OF_BOUNDS", "Index out of bounds for rope access");
+        return NULL;
+    }
+    return (char *)node->chunk + offset * rope->stride;
+}
+
+static char *_rope_flatten_into(const SpdaRopeNode *node, char *dst, size_t stride)
+{
+    if (!node) return dst;
+    dst = _rope_flatten_into(node->left, dst, stride);
+    size_t clen = spda_len(node->chunk);
+    memcpy(dst, node->chunk, clen * stride);
+    return _rope_flatten_into(node->right, dst + clen * stride, stride);
+}
+
+void *spda_rope_flatten(const SpdaRope *rope)
+{
+    if (!rope) {
+        raise("INVALID_SOURCE", "Source rope cannot be NULL");
+        return NULL;
+    }
+
+    size_t length = spda_rope_len(rope);
+    void *array = _spda_create(length, rope->stride);
+    if (array == NULL) return NULL;
+
+    _rope_flatten_into(rope->root, array, rope->stride);
+    _spda_field_set(array, LENGTH, length);
+    return array;
+}
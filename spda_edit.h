@@ -0,0 +1,90 @@
+/*
+**  @brief: Edit-friendly containers built on top of spda (gap buffer & chunked rope) **
+*   @Author: Samarth Pyati
+*   @Date : 19-10-2026
+*   @Version : 1.0
+*/
+
+#ifndef SPDA_EDIT_H_
+#define SPDA_EDIT_H_
+
+#include <stddef.h>         // size_t
+#include <stdbool.h>        // bool
+#include <stdint.h>         // uint32_t, uint64_t
+#include "spda.h"
+
+/*
+** Gap Buffer **
+* The backing store is a regular spda array whose capacity holds both the
+* elements and a movable hole (the gap). Edits near the previous edit only
+* shift the elements between the old and the new cursor, so clustered
+* inserts/removes cost O(1) amortized instead of O(n).
+*
+*  +-----------------+------------------------+-----------------+
+*  |   front items   |          gap           |    back items   |
+*  +-----------------+------------------------+-----------------+
+*  0             gap_start                 gap_end            capacity
+*
+* The LENGTH field of the backing array always holds the number of elements.
+* `spda_gap_view` moves the gap to the end which turns the buffer back into
+* a contiguous, plain spda array.
+*/
+typedef struct {
+    void *data;             // spda backing array
+    size_t gap_start;       // first slot of the gap
+    size_t gap_end;         // first slot after the gap
+} SpdaGap;
+
+/*
+** Chunked Rope **
+* A treap keyed implicitly by position whose nodes each own a small spda array
+* (chunk) of at most SPDA_ROPE_CHUNK elements. Every node caches the number of
+* elements in its subtree, so locating, inserting and removing at any index
+* costs O(log n) plus an O(SPDA_ROPE_CHUNK) memmove inside a single chunk.
+*/
+#define SPDA_ROPE_CHUNK 1024
+
+typedef struct SpdaRopeNode SpdaRopeNode;
+
+typedef struct {
+    SpdaRopeNode *root;
+    size_t stride;
+    uint64_t seed;          // treap priority generator state
+} SpdaRope;
+
+/* Gap Buffer Operations */
+SpdaGap *_spda_gap_create(size_t cap, size_t stride);
+SpdaGap *spda_gap_from(void *array);                        // takes ownership of `array`
+void spda_gap_destroy(SpdaGap *gb);
+void *spda_gap_release(SpdaGap *gb);                        // free the gap, return the contiguous spda array
+
+size_t spda_gap_len(const SpdaGap *gb);
+void spda_gap_move(SpdaGap *gb, size_t pos);                // move the gap (cursor) to `pos`
+bool spda_gap_insert(SpdaGap *gb, size_t pos, const void *value);
+bool spda_gap_insert_many(SpdaGap *gb, size_t pos, const void *items, size_t count);
+bool spda_gap_remove(SpdaGap *gb, size_t pos, size_t count);
+void *spda_gap_at(const SpdaGap *gb, size_t idx);
+void *spda_gap_view(SpdaGap *gb);                           // contiguous view, valid until the next edit
+
+/* Rope Operations */
+SpdaRope *_spda_rope_create(size_t stride);
+SpdaRope *spda_rope_from(const void *array);                // copies `array` into a new rope
+void spda_rope_destroy(SpdaRope *rope);
+
+size_t spda_rope_len(const SpdaRope *rope);
+bool spda_rope_insert(SpdaRope *rope, size_t idx, const void *value);
+bool spda_rope_remove(SpdaRope *rope, size_t idx);
+void *spda_rope_at(const SpdaRope *rope, size_t idx);
+void *spda_rope_flatten(const SpdaRope *rope);              // new spda array with every element in order
+
+/* Macros */
+#define spda_gap_create(type) \
+    _spda_gap_create(SPDA_DEFAULT_CAPACITY, sizeof(type))
+
+#define spda_gap_reserve(type, capacity) \
+    _spda_gap_create(capacity, sizeof(type))
+
+#define spda_rope_create(type) \
+    _spda_rope_create(sizeof(type))
+
+#endif // SPDA_EDIT_H_
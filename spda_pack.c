@@ -0,0 +1,476 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include "spda_pack.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/* Worst case encoded block (XOR: 78 bits per value) plus padding for 8 byte loads */
+#define SPDA_PACK_SCRATCH 2048
+#define SPDA_PACK_PADDING 8
+#define SPDA_PACK_HEADER (2 * sizeof(int64_t) + 1)
+
+static const size_t pack_type_size[] = {
+    [SPDA_PACK_I32] = sizeof(int32_t),
+    [SPDA_PACK_I64] = sizeof(int64_t),
+    [SPDA_PACK_F64] = sizeof(double),
+};
+
+/* ------------------------------------------------------------------------- */
+/*                               BIT STREAMS                                 */
+/* ------------------------------------------------------------------------- */
+
+/*
+* Little endian bit streams. Writes go through a 64 bit accumulator so the
+* output needs no zeroing; reads do unaligned 8 byte loads, which is why every
+* encoded buffer is followed by SPDA_PACK_PADDING bytes.
+*/
+typedef struct {
+    uint8_t *buf;
+    size_t bytes;           // bytes flushed so far
+    uint64_t acc;           // pending bits
+    unsigned fill;          // number of pending bits
+} BitWriter;
+
+static inline uint64_t _load64(const uint8_t *p)
+{
+    uint64_t w;
+    memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+static inline void _bits_write(BitWriter *bw, uint64_t value, unsigned n)
+{
+    bw->acc |= value << bw->fill;
+    if (bw->fill + n < 64) {
+        bw->fill += n;
+        return;
+    }
+    memcpy(bw->buf + bw->bytes, &bw->acc, sizeof(bw->acc));
+    bw->bytes += sizeof(bw->acc);
+    bw->acc = bw->fill ? value >> (64 - bw->fill) : 0;
+    bw->fill = bw->fill + n - 64;
+}
+
+static inline size_t _bits_flush(BitWriter *bw)
+{
+    memcpy(bw->buf + bw->bytes, &bw->acc, sizeof(bw->acc));
+    return bw->bytes + (bw->fill + 7) / 8;
+}
+
+static inline uint64_t _bits_read(const uint8_t *buf, size_t *pos, unsigned n)
+{
+    if (n > 56) {
+        uint64_t lo = _bits_read(buf, pos, 32);
+        return lo | (_bits_read(buf, pos, n - 32) << 32);
+    }
+    uint64_t value = (_load64(buf + (*pos >> 3)) >> (*pos & 7)) & ((1ULL << n) - 1);
+    *pos += n;
+    return value;
+}
+
+static inline unsigned _bit_width(uint64_t x)
+{
+    return x ? 64 - (unsigned)__builtin_clzll(x) : 0;
+}
+
+/*
+* Fixed width unpack fused with the delta prefix sum. Called with a constant
+* `width` from the dispatch switch below, so every width gets its own
+* straight-line loop with constant shifts and masks.
+*
+* The running sum is a serial dependency the compiler will not vectorize, so
+* the SIMD paths do it by hand: unpack a vector of deltas, prefix sum it
+* in-register (log2(lanes) shift + add steps) and add the broadcast total of
+* the previous vector. The scalar loop finishes the tail.
+*/
+static inline void _unpack_fixed(const uint8_t *src, uint64_t acc, uint64_t step, int64_t *v, size_t n, unsigned width)
+{
+    const uint64_t mask = (1ULL << width) - 1;
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i vmask = _mm256_set1_epi64x((long long)mask);
+    const __m256i vstep = _mm256_set1_epi64x((long long)step);
+    __m256i vacc = _mm256_set1_epi64x((long long)acc);
+    for (; i + 4 <= n; i += 4)
+    {
+        size_t b0 = i * width, b1 = b0 + width, b2 = b1 + width, b3 = b2 + width;
+        __m256i words = _mm256_set_epi64x((long long)_load64(src + (b3 >> 3)), (long long)_load64(src + (b2 >> 3)),
+                                          (long long)_load64(src + (b1 >> 3)), (long long)_load64(src + (b0 >> 3)));
+        __m256i shifts = _mm256_set_epi64x(b3 & 7, b2 & 7, b1 & 7, b0 & 7);
+        __m256i d = _mm256_add_epi64(_mm256_and_si256(_mm256_srlv_epi64(words, shifts), vmask), vstep);
+
+        /* [d0, d0+d1 | d2, d2+d3], then carry lane 1 into the upper half */
+        d = _mm256_add_epi64(d, _mm256_slli_si256(d, 8));
+        __m256i carry = _mm256_permute4x64_epi64(d, _MM_SHUFFLE(1, 1, 0, 0));
+        d = _mm256_add_epi64(d, _mm256_blend_epi32(_mm256_setzero_si256(), carry, 0xF0));
+        d = _mm256_add_epi64(d, vacc);
+        _mm256_storeu_si256((__m256i *)(v + i), d);
+        vacc = _mm256_permute4x64_epi64(d, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+#elif defined(__SSE2__)
+    const __m128i vmask = _mm_set1_epi64x((long long)mask);
+    const __m128i vstep = _mm_set1_epi64x((long long)step);
+    __m128i vacc = _mm_set1_epi64x((long long)acc);
+    for (; i + 2 <= n; i += 2)
+    {
+        size_t b0 = i * width, b1 = b0 + width;
+        __m128i words = _mm_set_epi64x((long long)_load64(src + (b1 >> 3)), (long long)_load64(src + (b0 >> 3)));
+
+        /* SSE2 has no per-lane shift: shift twice, keep lane 0 of one and lane 1 of the other */
+        __m128i lo = _mm_srli_epi64(words, (int)(b0 & 7));
+        __m128i hi = _mm_srli_epi64(words, (int)(b1 & 7));
+        __m128i d = _mm_unpackhi_epi64(_mm_unpacklo_epi64(lo, lo), hi);
+        d = _mm_add_epi64(_mm_and_si128(d, vmask), vstep);
+
+        d = _mm_add_epi64(d, _mm_slli_si128(d, 8));
+        d = _mm_add_epi64(d, vacc);
+        _mm_storeu_si128((__m128i *)(v + i), d);
+        vacc = _mm_unpackhi_epi64(d, d);
+    }
+#endif
+    if (i > 0) acc = (uint64_t)v[i - 1];
+
+    for (; i < n; ++i) {
+        size_t bit = i * width;
+        acc += step + ((_load64(src + (bit >> 3)) >> (bit & 7)) & mask);
+        v[i] = (int64_t)acc;
+    }
+}
+
+static void _unpack_width(const uint8_t *src, uint64_t acc, uint64_t step, int64_t *v, size_t n, unsigned width)
+{
+#define SPDA_UNPACK_CASE(w) case w: _unpack_fixed(src, acc, step, v, n, w); return;
+    switch (width) {
+        SPDA_UNPACK_CASE(0)
+        SPDA_UNPACK_CASE(1)  SPDA_UNPACK_CASE(2)  SPDA_UNPACK_CASE(3)  SPDA_UNPACK_CASE(4)
+        SPDA_UNPACK_CASE(5)  SPDA_UNPACK_CASE(6)  SPDA_UNPACK_CASE(7)  SPDA_UNPACK_CASE(8)
+        SPDA_UNPACK_CASE(9)  SPDA_UNPACK_CASE(10) SPDA_UNPACK_CASE(11) SPDA_UNPACK_CASE(12)
+        SPDA_UNPACK_CASE(13) SPDA_UNPACK_CASE(14) SPDA_UNPACK_CASE(15) SPDA_UNPACK_CASE(16)
+        SPDA_UNPACK_CASE(17) SPDA_UNPACK_CASE(18) SPDA_UNPACK_CASE(19) SPDA_UNPACK_CASE(20)
+        SPDA_UNPACK_CASE(21) SPDA_UNPACK_CASE(22) SPDA_UNPACK_CASE(23) SPDA_UNPACK_CASE(24)
+        SPDA_UNPACK_CASE(25) SPDA_UNPACK_CASE(26) SPDA_UNPACK_CASE(27) SPDA_UNPACK_CASE(28)
+        SPDA_UNPACK_CASE(29) SPDA_UNPACK_CASE(30) SPDA_UNPACK_CASE(31) SPDA_UNPACK_CASE(32)
+        default: break;
+    }
+#undef SPDA_UNPACK_CASE
+
+    /* Wide deltas are rare (random data), take the generic path */
+    size_t pos = 0;
+    for (size_t i = 0; i < n; ++i) {
+        acc += step + _bits_read(src, &pos, width);
+        v[i] = (int64_t)acc;
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/*                              BLOCK CODECS                                 */
+/* ------------------------------------------------------------------------- */
+
+static size_t _encode_delta_for(const int64_t *v, size_t n, uint8_t *out)
+{
+    int64_t min_delta = INT64_MAX;
+    uint64_t deltas[SPDA_PACK_BLOCK];
+    for (size_t i = 1; i < n; ++i) {
+        deltas[i] = (uint64_t)v[i] - (uint64_t)v[i - 1];
+        if ((int64_t)deltas[i] < min_delta) min_delta = (int64_t)deltas[i];
+    }
+    if (n < 2) min_delta = 0;
+
+    uint64_t max_offset = 0;
+    for (size_t i = 1; i < n; ++i) {
+        deltas[i] -= (uint64_t)min_delta;
+        if (deltas[i] > max_offset) max_offset = deltas[i];
+    }
+    uint8_t width = (uint8_t)_bit_width(max_offset);
+
+    memcpy(out, &v[0], sizeof(int64_t));
+    memcpy(out + sizeof(int64_t), &min_delta, sizeof(int64_t));
+    out[2 * sizeof(int64_t)] = width;
+
+    BitWriter bw = { .buf = out + SPDA_PACK_HEADER };
+    for (size_t i = 1; i < n; ++i) _bits_write(&bw, deltas[i], width);
+    return SPDA_PACK_HEADER + _bits_flush(&bw);
+}
+
+static void _decode_delta_for(const uint8_t *in, size_t n, int64_t *v)
+{
+    int64_t first, min_delta;
+    memcpy(&first, in, sizeof(int64_t));
+    memcpy(&min_delta, in + sizeof(int64_t), sizeof(int64_t));
+    unsigned width = in[2 * sizeof(int64_t)];
+
+    v[0] = first;
+    _unpack_width(in + SPDA_PACK_HEADER, (uint64_t)first, (uint64_t)min_delta, v + 1, n - 1, width);
+}
+
+static size_t _encode_varint(const int64_t *v, size_t n, uint8_t *out)
+{
+    size_t len = 0;
+    uint64_t prev = 0;
+    for (size_t i = 0; i < n; ++i) {
+        int64_t delta = (int64_t)((uint64_t)v[i] - prev);
+        uint64_t zz = ((uint64_t)delta << 1) ^ (uint64_t)(delta >> 63);
+        prev = (uint64_t)v[i];
+        while (zz >= 0x80) {
+            out[len++] = (uint8_t)(zz | 0x80);
+            zz >>= 7;
+        }
+        out[len++] = (uint8_t)zz;
+    }
+    return len;
+}
+
+static void _decode_varint(const uint8_t *in, size_t n, int64_t *v)
+{
+    uint64_t prev = 0;
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t zz = 0;
+        unsigned shift = 0;
+        uint8_t byte;
+        do {
+            byte = *in++;
+            zz |= (uint64_t)(byte & 0x7F) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        prev += (zz >> 1) ^ (~(zz & 1) + 1);
+        v[i] = (int64_t)prev;
+    }
+}
+
+static size_t _encode_xor(const int64_t *v, size_t n, uint8_t *out)
+{
+    BitWriter bw = { .buf = out };
+    uint64_t prev = (uint64_t)v[0];
+    unsigned lead = 64, trail = 0;          // no window yet
+    _bits_write(&bw, prev, 64);
+
+    for (size_t i = 1; i < n; ++i) {
+        uint64_t x = (uint64_t)v[i] ^ prev;
+        prev = (uint64_t)v[i];
+        if (x == 0) {
+            _bits_write(&bw, 0, 1);
+            continue;
+        }
+
+        unsigned l = (unsigned)__builtin_clzll(x), t = (unsigned)__builtin_ctzll(x);
+        if (lead != 64 && l >= lead && t >= trail) {
+            /* '01': meaningful bits fit the previous window */
+            _bits_write(&bw, 0x1, 2);
+            _bits_write(&bw, x >> trail, 64 - lead - trail);
+        } else {
+            /* '11': new window, 6 bits leading zeros, 6 bits (length - 1) */
+            lead = l;
+            trail = t;
+            _bits_write(&bw, 0x3, 2);
+            _bits_write(&bw, lead, 6);
+            _bits_write(&bw, 64 - lead - trail - 1, 6);
+            _bits_write(&bw, x >> trail, 64 - lead - trail);
+        }
+    }
+    return _bits_flush(&bw);
+}
+
+static void _decode_xor(const uint8_t *in, size_t n, int64_t *v)
+{
+    size_t pos = 0;
+    uint64_t prev = _bits_read(in, &pos, 64);
+    unsigned lead = 0, trail = 0;
+    v[0] = (int64_t)prev;
+
+    for (size_t i = 1; i < n; ++i) {
+        if (_bits_read(in, &pos, 1)) {
+            if (_bits_read(in, &pos, 1)) {
+                lead = (unsigned)_bits_read(in, &pos, 6);
+                trail = 64 - lead - ((unsigned)_bits_read(in, &pos, 6) + 1);
+            }
+            prev ^= _bits_read(in, &pos, 64 - lead - trail) << trail;
+        }
+        v[i] = (int64_t)prev;
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/*                                PUBLIC API                                 */
+/* ------------------------------------------------------------------------- */
+
+static bool _spda_pack_bytes(SpdaPacked *packed, const uint8_t *bytes, size_t n)
+{
+    size_t length = spda_len(packed->data);
+    size_t need = length + n + SPDA_PACK_PADDING;
+    if (need > spda_cap(packed->data))
+    {
+        size_t new_cap = spda_cap(packed->data) * SPDA_GROWTH_FACTOR;
+        if (new_cap < need) new_cap = need;
+        uint8_t *new_data = _spda_resize(packed->data, new_cap);
+        if (new_data == NULL) {
+            raise("MEM_ALLOCATION", "Failed to grow packed buffer");
+            return false;
+        }
+        packed->data = new_data;
+    }
+    memcpy(packed->data + length, bytes, n);
+    memset(packed->data + length + n, 0, SPDA_PACK_PADDING);
+    spda_set_length(packed->data, length + n);
+    return true;
+}
+
+static inline void _load_block(const void *array, SpdaPackType type, size_t start, size_t n, int64_t *v)
+{
+    if (type == SPDA_PACK_I32) {
+        const int32_t *src = (const int32_t *)array + start;
+        for (size_t i = 0; i < n; ++i) v[i] = src[i];
+    } else {
+        memcpy(v, (const int64_t *)array + start, n * sizeof(int64_t));
+    }
+}
+
+static inline void _store_block(void *out, SpdaPackType type, const int64_t *v, size_t n)
+{
+    if (type == SPDA_PACK_I32) {
+        int32_t *dst = out;
+        for (size_t i = 0; i < n; ++i) dst[i] = (int32_t)v[i];
+    } else {
+        memcpy(out, v, n * sizeof(int64_t));
+    }
+}
+
+SpdaPacked *spda_pack(const void *array, SpdaPackType type, SpdaPackCodec codec)
+{
+    if (!array) {
+        raise("INVALID_SOURCE", "Source array cannot be NULL");
+        return NULL;
+    }
+    if (spda_stride(array) != pack_type_size[type]) {
+        raise("INVALID_ARGUMENT", "Array stride does not match the pack type");
+        return NULL;
+    }
+    if ((codec == SPDA_PACK_XOR) != (type == SPDA_PACK_F64)) {
+        raise("INVALID_ARGUMENT", "XOR codec is for doubles, DELTA_FOR / VARINT for integers");
+        return NULL;
+    }
+
+    SpdaPacked *packed = malloc(sizeof(SpdaPacked));
+    if (packed == NULL) {
+        raise("MEM_ALLOCATION", "Failed to allocate packed array");
+        return NULL;
+    }
+
+    size_t length = spda_len(array);
+    size_t block_count = (length + SPDA_PACK_BLOCK - 1) / SPDA_PACK_BLOCK;
+    packed->codec = codec;
+    packed->type = type;
+    packed->count = length;
+    packed->blocks = spda_reserve(size_t, block_count);
+    packed->data = spda_reserve(uint8_t, SPDA_PACK_PADDING + length);
+    if (!packed->blocks || !packed->data) {
+        spda_packed_destroy(packed);
+        return NULL;
+    }
+    memset(packed->data, 0, SPDA_PACK_PADDING);
+
+    int64_t values[SPDA_PACK_BLOCK];
+    uint8_t scratch[SPDA_PACK_SCRATCH + SPDA_PACK_PADDING];
+    for (size_t start = 0; start < length; start += SPDA_PACK_BLOCK)
+    {
+        size_t n = length - start < SPDA_PACK_BLOCK ? length - start : SPDA_PACK_BLOCK;
+        _load_block(array, type, start, n, values);
+
+        size_t bytes = 0;
+        switch (codec) {
+            case SPDA_PACK_DELTA_FOR: bytes = _encode_delta_for(values, n, scratch); break;
+            case SPDA_PACK_VARINT:    bytes = _encode_varint(values, n, scratch); break;
+            case SPDA_PACK_XOR:       bytes = _encode_xor(values, n, scratch); break;
+        }
+
+        size_t offset = spda_len(packed->data);
+        spda_append(packed->blocks, offset);
+        if (!_spda_pack_bytes(packed, scratch, bytes)) {
+            spda_packed_destroy(packed);
+            return NULL;
+        }
+    }
+    return packed;
+}
+
+void spda_packed_destroy(SpdaPacked *packed)
+{
+    if (!packed) return;
+    spda_destroy(packed->blocks);
+    spda_destroy(packed->data);
+    free(packed);
+}
+
+size_t spda_packed_bytes(const SpdaPacked *packed)
+{
+    return spda_len(packed->data) + spda_len(packed->blocks) * sizeof(size_t) + sizeof(SpdaPacked);
+}
+
+size_t spda_unpack_block(const SpdaPacked *packed, size_t block, void *out)
+{
+    if (!packed || block >= spda_len(packed->blocks)) {
+        raise("INDEX_OUT_OF_BOUNDS", "Block index out of bounds for unpack");
+        return 0;
+    }
+
+    size_t start = block * SPDA_PACK_BLOCK;
+    size_t n = packed->count - start < SPDA_PACK_BLOCK ? packed->count - start : SPDA_PACK_BLOCK;
+    const uint8_t *in = packed->data + packed->blocks[block];
+
+    /* 64 bit element types decode straight into the destination */
+    int64_t values[SPDA_PACK_BLOCK];
+    int64_t *v = packed->type == SPDA_PACK_I32 ? values : out;
+    switch (packed->codec) {
+        case SPDA_PACK_DELTA_FOR: _decode_delta_for(in, n, v); break;
+        case SPDA_PACK_VARINT:    _decode_varint(in, n, v); break;
+        case SPDA_PACK_XOR:       _decode_xor(in, n, v); break;
+    }
+    if (v == values) _store_block(out, packed->type, values, n);
+    return n;
+}
+
+bool spda_unpack_range(const SpdaPacked *packed, size_t start, size_t count, void *out)
+{
+    if (!packed || start > packed->count || count > packed->count - start) {
+        raise("INDEX_OUT_OF_BOUNDS", "Range out of bounds for unpack");
+        return false;
+    }
+
+    size_t stride = pack_type_size[packed->type];
+    int64_t block_values[SPDA_PACK_BLOCK];
+    char *dst = out;
+    while (count > 0)
+    {
+        size_t block = start / SPDA_PACK_BLOCK;
+        size_t skip = start % SPDA_PACK_BLOCK;
+        size_t n = spda_unpack_block(packed, block, block_values);
+        size_t take = n - skip < count ? n - skip : count;
+        memcpy(dst, (char *)block_values + skip * stride, take * stride);
+        dst += take * stride;
+        start += take;
+        count -= take;
+    }
+    return true;
+}
+
+void *spda_unpack(const SpdaPacked *packed)
+{
+    if (!packed) {
+        raise("INVALID_SOURCE", "Source packed array cannot be NULL");
+        return NULL;
+    }
+
+    size_t stride = pack_type_size[packed->type];
+    char *array = _spda_create(packed->count, stride);
+    if (array == NULL) return NULL;
+
+    for (size_t block = 0; block < spda_len(packed->blocks); ++block)
+        spda_unpack_block(packed, block, array + block * SPDA_PACK_BLOCK * stride);
+    spda_set_length(array, packed->count);
+    return array;
+}
@@ -0,0 +1,73 @@
+/*
+**  @brief: Columnar compression for integer and floating point spda arrays **
+*   @Author: Samarth Pyati
+*   @Date : 19-10-2026
+*   @Version : 1.0
+*/
+
+#ifndef SPDA_PACK_H_
+#define SPDA_PACK_H_
+
+#include <stddef.h>         // size_t
+#include <stdint.h>         // uint8_t
+#include <stdbool.h>        // bool
+#include "spda.h"
+
+/*
+** Packed Arrays **
+* Elements are encoded in independent blocks of SPDA_PACK_BLOCK values and
+* `blocks` records the byte offset of every block, so any region can be decoded
+* without inflating the whole array.
+*
+* Codecs:
+*   SPDA_PACK_DELTA_FOR : deltas, frame of reference (min delta) and fixed width
+*                         bit packing. Best for sorted / slowly varying ints.
+*   SPDA_PACK_VARINT    : zig-zag encoded deltas as LEB128 varints.
+*   SPDA_PACK_XOR       : Gorilla style XOR with the previous value, for doubles.
+*
+*  Structure of a DELTA_FOR block:
+*  +-------------+-------------+---------+--------------------------------------+
+*  |    first    |  min_delta  |  width  |   (n - 1) x width bits of deltas     |
+*  +-------------+-------------+---------+--------------------------------------+
+*  |  (int64_t)  |  (int64_t)  | (uint8) |                                      |
+*  +-------------+-------------+---------+--------------------------------------+
+*/
+
+#define SPDA_PACK_BLOCK 128
+
+typedef enum {
+    SPDA_PACK_I32,
+    SPDA_PACK_I64,
+    SPDA_PACK_F64,
+} SpdaPackType;
+
+typedef enum {
+    SPDA_PACK_DELTA_FOR,
+    SPDA_PACK_VARINT,
+    SPDA_PACK_XOR,
+} SpdaPackCodec;
+
+typedef struct {
+    SpdaPackCodec codec;
+    SpdaPackType type;
+    size_t count;           // number of encoded elements
+    size_t *blocks;         // spda array, byte offset of each block in `data`
+    uint8_t *data;          // spda array of encoded bytes
+} SpdaPacked;
+
+/* Encoding */
+SpdaPacked *spda_pack(const void *array, SpdaPackType type, SpdaPackCodec codec);
+void spda_packed_destroy(SpdaPacked *packed);
+size_t spda_packed_bytes(const SpdaPacked *packed);         // encoded size including the block index
+
+/* Decoding */
+size_t spda_unpack_block(const SpdaPacked *packed, size_t block, void *out);        // returns elements written
+bool spda_unpack_range(const SpdaPacked *packed, size_t start, size_t count, void *out);
+void *spda_unpack(const SpdaPacked *packed);                 // new spda array with every element
+
+/* Macros */
+#define spda_pack_i32(array, codec) spda_pack((array), SPDA_PACK_I32, (codec))
+#define spda_pack_i64(array, codec) spda_pack((array), SPDA_PACK_I64, (codec))
+#define spda_pack_f64(array)        spda_pack((array), SPDA_PACK_F64, SPDA_PACK_XOR)
+
+#endif // SPDA_PACK_H_
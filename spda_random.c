@@ -0,0 +1,342 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include "spda_random.h"
+
+#define SPDA_TWO_PI 6.283185307179586476925286766559
+
+static inline uint64_t _rotl(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+static inline uint64_t _splitmix64(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/*
+* Uniform in [0, bound) for bound <= 2^32: the high 64 bits of r * bound,
+* built from two 32 x 32 bit products so no 128-bit multiply is needed.
+* Using all 64 random bits keeps the bias below bound / 2^64 <= 2^-32.
+*/
+static inline uint64_t _reduce32(uint64_t r, uint64_t bound)
+{
+    return ((r >> 32) * bound + (((r & 0xFFFFFFFFu) * bound) >> 32)) >> 32;
+}
+
+/* ------------------------------------------------------------------------- */
+/*                                 GENERATOR                                 */
+/* ------------------------------------------------------------------------- */
+
+void spda_rng_seed(SpdaRng *rng, uint64_t seed)
+{
+    for (int i = 0; i < 4; ++i) rng->s[i] = _splitmix64(&seed);
+}
+
+uint64_t spda_rng_next(SpdaRng *rng)
+{
+    uint64_t *s = rng->s;
+    const uint64_t result = _rotl(s[1] * 5, 7) * 9;
+    const uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = _rotl(s[3], 45);
+    return result;
+}
+
+void spda_rng_jump(SpdaRng *rng)
+{
+    static const uint64_t JUMP[] = {
+        0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL
+    };
+
+    uint64_t s[4] = {0};
+    for (size_t i = 0; i < CARRAY_LEN(JUMP); ++i)
+    {
+        for (int b = 0; b < 64; ++b)
+        {
+            if (JUMP[i] & (1ULL << b)) {
+                for (int k = 0; k < 4; ++k) s[k] ^= rng->s[k];
+            }
+            spda_rng_next(rng);
+        }
+    }
+    memcpy(rng->s, s, sizeof(s));
+}
+
+int spda_rng_int(SpdaRng *rng, int min, int max)
+{
+    uint64_t range = (uint64_t)((int64_t)max - (int64_t)min) + 1;
+    return (int)((int64_t)min + (int64_t)_reduce32(spda_rng_next(rng), range));
+}
+
+double spda_rng_double(SpdaRng *rng)
+{
+    return (double)(spda_rng_next(rng) >> 11) * 0x1.0p-53;
+}
+
+/* ------------------------------------------------------------------------- */
+/*                                BATCH FILL                                 */
+/* ------------------------------------------------------------------------- */
+
+/* Raw 64 bit outputs of block `block`: SPDA_RNG_LANES xoshiro256** states in lockstep */
+static void _rng_block(uint64_t seed, size_t block, uint64_t *out)
+{
+    uint64_t s0[SPDA_RNG_LANES], s1[SPDA_RNG_LANES], s2[SPDA_RNG_LANES], s3[SPDA_RNG_LANES];
+    uint64_t sm = seed ^ (0xD1B54A32D192ED03ULL * ((uint64_t)block + 1));
+    for (int l = 0; l < SPDA_RNG_LANES; ++l) {
+        s0[l] = _splitmix64(&sm);
+        s1[l] = _splitmix64(&sm);
+        s2[l] = _splitmix64(&sm);
+        s3[l] = _splitmix64(&sm);
+    }
+
+    for (size_t i = 0; i < SPDA_RNG_BLOCK; i += SPDA_RNG_LANES)
+    {
+        for (int l = 0; l < SPDA_RNG_LANES; ++l) {
+            out[i + l] = _rotl(s1[l] * 5, 7) * 9;
+            const uint64_t t = s1[l] << 17;
+            s2[l] ^= s0[l];
+            s3[l] ^= s1[l];
+            s1[l] ^= s2[l];
+            s0[l] ^= s3[l];
+            s2[l] ^= t;
+            s3[l] = _rotl(s3[l], 45);
+        }
+    }
+}
+
+/* Walks [start, start + count) one block at a time */
+typedef struct {
+    uint64_t seed;
+    size_t next;
+    size_t end;
+    uint64_t raw[SPDA_RNG_BLOCK];
+} FillCursor;
+
+/* Returns how many elements of the current block to convert, starting at raw[*offset] */
+static size_t _fill_next(FillCursor *cur, size_t *at, size_t *offset)
+{
+    if (cur->next >= cur->end) return 0;
+
+    size_t block = cur->next / SPDA_RNG_BLOCK;
+    size_t block_end = (block + 1) * SPDA_RNG_BLOCK;
+    size_t n = (block_end < cur->end ? block_end : cur->end) - cur->next;
+
+    _rng_block(cur->seed, block, cur->raw);
+    *at = cur->next;
+    *offset = cur->next % SPDA_RNG_BLOCK;
+    cur->next += n;
+    return n;
+}
+
+static bool _fill_check(const void *array, size_t start, size_t count)
+{
+    if (!array) {
+        raise("INVALID_SOURCE", "Source array cannot be NULL");
+        return false;
+    }
+    if (start > spda_cap(array) || count > spda_cap(array) - start) {
+        raise("INDEX_OUT_OF_BOUNDS", "Fill range exceeds the array capacity");
+        return false;
+    }
+    return true;
+}
+
+void spda_fill_int(int *array, size_t start, size_t count, uint64_t seed, int min, int max)
+{
+    if (!_fill_check(array, start, count)) return;
+    if (min > max) {
+        raise("INVALID_ARGUMENT", "Minimum cannot exceed maximum");
+        return;
+    }
+
+    uint64_t range = (uint64_t)((int64_t)max - (int64_t)min) + 1;
+    FillCursor cur = { .seed = seed, .next = start, .end = start + count };
+    size_t at, off, n;
+    while ((n = _fill_next(&cur, &at, &off)) > 0)
+    {
+        const uint64_t *raw = cur.raw + off;
+        int *dst = array + at;
+        for (size_t i = 0; i < n; ++i) dst[i] = (int)((int64_t)min + (int64_t)_reduce32(raw[i], range));
+    }
+}
+
+void spda_fill_float(float *array, size_t start, size_t count, uint64_t seed, float min, float max)
+{
+    if (!_fill_check(array, start, count)) return;
+
+    const float scale = (max - min) * 0x1.0p-24f;
+    FillCursor cur = { .seed = seed, .next = start, .end = start + count };
+    size_t at, off, n;
+    while ((n = _fill_next(&cur, &at, &off)) > 0)
+    {
+        const uint64_t *raw = cur.raw + off;
+        float *dst = array + at;
+        for (size_t i = 0; i < n; ++i) dst[i] = min + (float)(raw[i] >> 40) * scale;
+    }
+}
+
+void spda_fill_double(double *array, size_t start, size_t count, uint64_t seed, double min, double max)
+{
+    if (!_fill_check(array, start, count)) return;
+
+    const double scale = (max - min) * 0x1.0p-53;
+    FillCursor cur = { .seed = seed, .next = start, .end = start + count };
+    size_t at, off, n;
+    while ((n = _fill_next(&cur, &at, &off)) > 0)
+    {
+        const uint64_t *raw = cur.raw + off;
+        double *dst = array + at;
+        for (size_t i = 0; i < n; ++i) dst[i] = min + (double)(raw[i] >> 11) * scale;
+    }
+}
+
+void spda_fill_normal(double *array, size_t start, size_t count, uint64_t seed, double mean, double stddev)
+{
+    if (!_fill_check(array, start, count)) return;
+
+    /* Box-Muller: element pair (2k, 2k + 1) of a block shares raw outputs 2k and 2k + 1 */
+    FillCursor cur = { .seed = seed, .next = start, .end = start + count };
+    size_t at, off, n;
+    while ((n = _fill_next(&cur, &at, &off)) > 0)
+    {
+        double *dst = array + at;
+        for (size_t i = off; i < off + n;)
+        {
+            size_t k = i & ~(size_t)1;
+            double u1 = 1.0 - (double)(cur.raw[k] >> 11) * 0x1.0p-53;       // (0, 1], log safe
+            double u2 = (double)(cur.raw[k + 1] >> 11) * 0x1.0p-53;
+            double r = stddev * sqrt(-2.0 * log(u1));
+            if (!(i & 1)) {
+                *dst++ = mean + r * cos(SPDA_TWO_PI * u2);
+                ++i;
+            }
+            if (i < off + n) {
+                *dst++ = mean + r * sin(SPDA_TWO_PI * u2);
+                ++i;
+            }
+        }
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/*                               WHOLE ARRAYS                                */
+/* ------------------------------------------------------------------------- */
+
+int *spda_rand_int(size_t n, uint64_t seed, int min, int max)
+{
+    if (min > max) {
+        raise("INVALID_ARGUMENT", "Minimum cannot exceed maximum");
+        return NULL;
+    }
+    int *array = spda_reserve(int, n);
+    if (array == NULL) return NULL;
+    spda_fill_int(array, 0, n, seed, min, max);
+    spda_set_length(array, n);
+    return array;
+}
+
+float *spda_rand_float(size_t n, uint64_t seed, float min, float max)
+{
+    float *array = spda_reserve(float, n);
+    if (array == NULL) return NULL;
+    spda_fill_float(array, 0, n, seed, min, max);
+    spda_set_length(array, n);
+    return array;
+}
+
+double *spda_rand_double(size_t n, uint64_t seed, double min, double max)
+{
+    double *array = spda_reserve(double, n);
+    if (array == NULL) return NULL;
+    spda_fill_double(array, 0, n, seed, min, max);
+    spda_set_length(array, n);
+    return array;
+}
+
+double *spda_rand_normal(size_t n, uint64_t seed, double mean, double stddev)
+{
+    double *array = spda_reserve(double, n);
+    if (array == NULL) return NULL;
+    spda_fill_normal(array, 0, n, seed, mean, stddev);
+    spda_set_length(array, n);
+    return array;
+}
+
+/* High 64 bits of a * b; four 32 x 32 products where there is no 128 bit type */
+static inline uint64_t _mulhi64(uint64_t a, uint64_t b)
+{
+#if defined(__SIZEOF_INT128__)
+    return (uint64_t)(((unsigned __int128)a * b) >> 64);
+#else
+    uint64_t a_lo = a & 0xFFFFFFFFu, a_hi = a >> 32;
+    uint64_t b_lo = b & 0xFFFFFFFFu, b_hi = b >> 32;
+    uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo;
+    uint64_t lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+    uint64_t mid = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFu) + lo_hi;
+    return hi_hi + (hi_lo >> 32) + (mid >> 32);
+#endif
+}
+
+/* Uniform in [0, bound) over the full 64 bit range */
+static inline size_t _rng_below(SpdaRng *rng, size_t bound)
+{
+    return (size_t)_mulhi64(spda_rng_next(rng), bound);
+}
+
+int *spda_rand_permutation(size_t n, uint64_t seed)
+{
+    int *array = spda_reserve(int, n);
+    if (array == NULL) return NULL;
+
+    SpdaRng rng;
+    spda_rng_seed(&rng, seed);
+
+    /* Inside-out Fisher-Yates: builds the shuffled identity in one pass */
+    for (size_t i = 0; i < n; ++i)
+    {
+        size_t j = _rng_below(&rng, i + 1);
+        array[i] = array[j];
+        array[j] = (int)i;
+    }
+    spda_set_length(array, n);
+    return array;
+}
+
+void spda_shuffle(void *array, uint64_t seed)
+{
+    if (!array) {
+        raise("INVALID_SOURCE", "Source array cannot be NULL");
+        return;
+    }
+
+    size_t length = spda_len(array);
+    size_t stride = spda_stride(array);
+    char *temp = malloc(stride);
+    if (!temp) {
+        raise("MEM_ALLOCATION", "Failed to allocate temporary buffer");
+        return;
+    }
+
+    SpdaRng rng;
+    spda_rng_seed(&rng, seed);
+    for (size_t i = length; i > 1; --i)
+    {
+        size_t j = _rng_below(&rng, i);
+        char *a = (char *)array + (i - 1) * stride;
+        char *b = (char *)array + j * stride;
+        memcpy(temp, a, stride);
+        memcpy(a, b, stride);
+        memcpy(b, temp, stride);
+    }
+    free(temp);
+}
@@ -0,0 +1,62 @@
+/*
+**  @brief: Fast, seedable and splittable random array generation for spda **
+*   @Author: Samarth Pyati
+*   @Date : 19-10-2026
+*   @Version : 1.0
+*/
+
+#ifndef SPDA_RANDOM_H_
+#define SPDA_RANDOM_H_
+
+#include <stddef.h>         // size_t
+#include <stdint.h>         // uint64_t
+#include "spda.h"
+
+/*
+** Generator **
+* xoshiro256** seeded through splitmix64. `spda_rng_jump` advances a generator
+* by 2^128 steps, handing out non-overlapping streams for sequential use.
+*
+** Batch Fill **
+* The spda_fill_* functions are counter based: element `i` of the output only
+* depends on (seed, i). The index space is cut into blocks of SPDA_RNG_BLOCK
+* elements, each generated by SPDA_RNG_LANES interleaved xoshiro states seeded
+* from (seed, block), which lets the compiler vectorize the lanes.
+*
+* They write into [start, start + count) of an array that already has the
+* capacity and never touch its length, so several threads may fill disjoint
+* ranges concurrently and the result is identical to a single call.
+*
+* Uniform integers use the multiply-shift range reduction on all 64 random
+* bits, so each value's probability is off by at most 2^-32 relative.
+*/
+
+#define SPDA_RNG_BLOCK 1024
+#define SPDA_RNG_LANES 4
+
+typedef struct {
+    uint64_t s[4];
+} SpdaRng;
+
+/* Generator */
+void spda_rng_seed(SpdaRng *rng, uint64_t seed);
+uint64_t spda_rng_next(SpdaRng *rng);
+void spda_rng_jump(SpdaRng *rng);                                       // independent stream 2^128 steps ahead
+int spda_rng_int(SpdaRng *rng, int min, int max);                       // uniform in [min, max]
+double spda_rng_double(SpdaRng *rng);                                   // uniform in [0, 1)
+
+/* Batch Fill (into reserved capacity, length untouched) */
+void spda_fill_int(int *array, size_t start, size_t count, uint64_t seed, int min, int max);
+void spda_fill_float(float *array, size_t start, size_t count, uint64_t seed, float min, float max);
+void spda_fill_double(double *array, size_t start, size_t count, uint64_t seed, double min, double max);
+void spda_fill_normal(double *array, size_t start, size_t count, uint64_t seed, double mean, double stddev);
+
+/* Whole Arrays */
+int *spda_rand_int(size_t n, uint64_t seed, int min, int max);
+float *spda_rand_float(size_t n, uint64_t seed, float min, float max);
+double *spda_rand_double(size_t n, uint64_t seed, double min, double max);
+double *spda_rand_normal(size_t n, uint64_t seed, double mean, double stddev);
+int *spda_rand_permutation(size_t n, uint64_t seed);                    // shuffled 0 .. n - 1
+void spda_shuffle(void *array, uint64_t seed);                          // Fisher-Yates, any element type
+
+#endif // SPDA_RANDOM_H_
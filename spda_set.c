@@ -0,0 +1,330 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include "spda_set.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/* Smaller side is galloped through the larger one above this size ratio */
+#define SPDA_GALLOP_RATIO 32
+
+/* What a two-way pass emits for keys only in a, in both, or only in b */
+enum {
+    SET_EMIT_A    = 1 << 0,
+    SET_EMIT_BOTH = 1 << 1,
+    SET_EMIT_B    = 1 << 2,
+};
+
+static bool _spda_set_check(const void *a, const void *b)
+{
+    if (!a || !b) {
+        raise("INVALID_SOURCE", "Source array cannot be NULL");
+        return false;
+    }
+    if (spda_stride(a) != spda_stride(b)) {
+        raise("INVALID_ARGUMENT", "Arrays must have the same stride");
+        return false;
+    }
+    return true;
+}
+
+static void *_spda_setop(const void *a, const void *b, SpdaCompar compar, int mode, size_t reserve)
+{
+    if (!_spda_set_check(a, b)) return NULL;
+
+    size_t stride = spda_stride(a);
+    size_t na = spda_len(a), nb = spda_len(b);
+    char *out = _spda_create(reserve, stride);
+    if (out == NULL) return NULL;
+
+    const char *pa = a, *pb = b;
+    const char *ea = pa + na * stride, *eb = pb + nb * stride;
+    char *dst = out;
+    while (pa < ea && pb < eb)
+    {
+        int c = compar(pa, pb);
+        if (c < 0) {
+            if (mode & SET_EMIT_A) { memcpy(dst, pa, stride); dst += stride; }
+            pa += stride;
+        } else if (c > 0) {
+            if (mode & SET_EMIT_B) { memcpy(dst, pb, stride); dst += stride; }
+            pb += stride;
+        } else {
+            if (mode & SET_EMIT_BOTH) { memcpy(dst, pa, stride); dst += stride; }
+            pa += stride;
+            pb += stride;
+        }
+    }
+
+    /* Whatever is left of one side has no partner in the other */
+    if ((mode & SET_EMIT_A) && pa < ea) {
+        memcpy(dst, pa, ea - pa);
+        dst += ea - pa;
+    }
+    if ((mode & SET_EMIT_B) && pb < eb) {
+        memcpy(dst, pb, eb - pb);
+        dst += eb - pb;
+    }
+
+    spda_set_length(out, (dst - out) / stride);
+    return out;
+}
+
+void *spda_merge(const void *a, const void *b, SpdaCompar compar)
+{
+    if (!_spda_set_check(a, b)) return NULL;
+
+    size_t stride = spda_stride(a);
+    size_t na = spda_len(a), nb = spda_len(b);
+    char *out = _spda_create(na + nb, stride);
+    if (out == NULL) return NULL;
+
+    /* `<=` keeps the merge stable: on ties the element of `a` goes first */
+    const char *pa = a, *pb = b;
+    const char *ea = pa + na * stride, *eb = pb + nb * stride;
+    char *dst = out;
+    while (pa < ea && pb < eb)
+    {
+        if (compar(pa, pb) <= 0) { memcpy(dst, pa, stride); pa += stride; }
+        else                     { memcpy(dst, pb, stride); pb += stride; }
+        dst += stride;
+    }
+    memcpy(dst, pa, ea - pa);
+    dst += ea - pa;
+    memcpy(dst, pb, eb - pb);
+
+    spda_set_length(out, na + nb);
+    return out;
+}
+
+void *spda_union(const void *a, const void *b, SpdaCompar compar)
+{
+    size_t reserve = a && b ? spda_len(a) + spda_len(b) : 0;
+    return _spda_setop(a, b, compar, SET_EMIT_A | SET_EMIT_BOTH | SET_EMIT_B, reserve);
+}
+
+void *spda_intersect(const void *a, const void *b, SpdaCompar compar)
+{
+    size_t reserve = a && b ? (spda_len(a) < spda_len(b) ? spda_len(a) : spda_len(b)) : 0;
+    return _spda_setop(a, b, compar, SET_EMIT_BOTH, reserve);
+}
+
+void *spda_difference(const void *a, const void *b, SpdaCompar compar)
+{
+    size_t reserve = a ? spda_len(a) : 0;
+    return _spda_setop(a, b, compar, SET_EMIT_A, reserve);
+}
+
+void *spda_symdiff(const void *a, const void *b, SpdaCompar compar)
+{
+    size_t reserve = a && b ? spda_len(a) + spda_len(b) : 0;
+    return _spda_setop(a, b, compar, SET_EMIT_A | SET_EMIT_B, reserve);
+}
+
+/* ------------------------------------------------------------------------- */
+/*                          INTEGER INTERSECTION                             */
+/* ------------------------------------------------------------------------- */
+
+/* First index in [from, nb) with b[idx] >= x, by exponential then binary search */
+static inline size_t _gallop(const int *b, size_t from, size_t nb, int x)
+{
+    if (from >= nb || b[from] >= x) return from;
+
+    size_t lo = from, step = 1;              // invariant: b[lo] < x
+    while (lo + step < nb && b[lo + step] < x) {
+        lo += step;
+        step <<= 1;
+    }
+    size_t l = lo + 1, h = lo + step < nb ? lo + step : nb;
+    while (l < h) {
+        size_t mid = l + (h - l) / 2;
+        if (b[mid] < x) l = mid + 1;
+        else h = mid;
+    }
+    return l;
+}
+
+static size_t _intersect_gallop(const int *a, size_t na, const int *b, size_t nb, int *out)
+{
+    size_t n = 0, j = 0;
+    for (size_t i = 0; i < na && j < nb; ++i)
+    {
+        j = _gallop(b, j, nb, a[i]);
+        if (j < nb && b[j] == a[i]) out[n++] = b[j++];
+    }
+    return n;
+}
+
+static size_t _intersect_scan(const int *a, size_t na, const int *b, size_t nb, int *out)
+{
+    size_t n = 0, i = 0, j = 0;
+
+#if defined(__SSE2__)
+    /*
+    * Compare 4 keys of `a` against 4 keys of `b` at once: one equality test
+    * per rotation of the `b` block covers all 16 pairs. Keys are distinct,
+    * so each lane of `a` matches at most once.
+    */
+    while (i + 4 <= na && j + 4 <= nb)
+    {
+        __m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(b + j));
+        __m128i eq = _mm_cmpeq_epi32(va, vb);
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+        for (int lane = 0; mask; ++lane, mask >>= 1) {
+            if (mask & 1) out[n++] = a[i + lane];
+        }
+
+        int amax = a[i + 3], bmax = b[j + 3];
+        if (amax <= bmax) i += 4;
+        if (bmax <= amax) j += 4;
+    }
+#endif
+
+    while (i < na && j < nb)
+    {
+        if (a[i] < b[j]) ++i;
+        else if (a[i] > b[j]) ++j;
+        else {
+            out[n++] = a[i];
+            ++i;
+            ++j;
+        }
+    }
+    return n;
+}
+
+int *spda_intersect_int(const int *a, const int *b)
+{
+    if (!_spda_set_check(a, b)) return NULL;
+
+    /* Always walk the smaller side */
+    if (spda_len(a) > spda_len(b)) {
+        const int *t = a;
+        a = b;
+        b = t;
+    }
+    size_t na = spda_len(a), nb = spda_len(b);
+
+    int *out = spda_reserve(int, na);
+    if (out == NULL) return NULL;
+
+    size_t n = na > 0 && nb / na >= SPDA_GALLOP_RATIO
+        ? _intersect_gallop(a, na, b, nb, out)
+        : _intersect_scan(a, na, b, nb, out);
+    spda_set_length(out, n);
+    return out;
+}
+
+/* ------------------------------------------------------------------------- */
+/*                               K-WAY MERGE                                 */
+/* ------------------------------------------------------------------------- */
+
+typedef struct {
+    const void *const *arrays;
+    size_t *pos;                // read cursor of each input
+    size_t *len;                // length of each input
+    size_t k;
+    size_t stride;
+    SpdaCompar compar;
+} LoserTree;
+
+/*
+* Does source `x` beat source `y`? Index k is the "minus infinity" sentinel
+* used while building the tree, exhausted sources lose to everything and ties
+* go to the lower index to keep the merge stable.
+*/
+static inline bool _lt_beats(const LoserTree *lt, size_t x, size_t y)
+{
+    if (x == lt->k) return true;
+    if (y == lt->k) return false;
+
+    bool x_done = lt->pos[x] >= lt->len[x];
+    bool y_done = lt->pos[y] >= lt->len[y];
+    if (x_done || y_done) return !x_done || (y_done && x < y);
+
+    int c = lt->compar((const char *)lt->arrays[x] + lt->pos[x] * lt->stride,
+                       (const char *)lt->arrays[y] + lt->pos[y] * lt->stride);
+    return c < 0 || (c == 0 && x < y);
+}
+
+/* Replay the matches from leaf `s` to the root; tree[0] ends up holding the winner */
+static inline void _lt_adjust(const LoserTree *lt, size_t *tree, size_t s)
+{
+    for (size_t t = (s + lt->k) / 2; t > 0; t /= 2)
+    {
+        if (_lt_beats(lt, tree[t], s)) {
+            size_t loser = s;
+            s = tree[t];
+            tree[t] = loser;
+        }
+    }
+    tree[0] = s;
+}
+
+void *spda_merge_k(void *out, const void *const *arrays, size_t k, SpdaCompar compar)
+{
+    if (!out || (k > 0 && !arrays)) {
+        raise("INVALID_SOURCE", "Source array cannot be NULL");
+        return out;
+    }
+
+    size_t stride = spda_stride(out);
+    size_t total = 0;
+    for (size_t i = 0; i < k; ++i)
+    {
+        if (!arrays[i] || spda_stride(arrays[i]) != stride) {
+            raise("INVALID_ARGUMENT", "Arrays must be valid and have the same stride");
+            return out;
+        }
+        total += spda_len(arrays[i]);
+    }
+
+    if (spda_cap(out) < total) {
+        void *new_out = _spda_resize(out, total);
+        if (new_out == NULL) {
+            raise("MEM_ALLOCATION", "Failed to reserve the merge output");
+            return out;
+        }
+        out = new_out;
+    }
+    if (k == 0) {
+        spda_set_length(out, 0);
+        return out;
+    }
+
+    size_t *scratch = malloc(3 * k * sizeof(size_t));
+    if (scratch == NULL) {
+        raise("MEM_ALLOCATION", "Failed to allocate the loser tree");
+        return out;
+    }
+    size_t *tree = scratch, *pos = scratch + k, *len = scratch + 2 * k;
+
+    LoserTree lt = { .arrays = arrays, .pos = pos, .len = len, .k = k, .stride = stride, .compar = compar };
+    for (size_t i = 0; i < k; ++i) {
+        tree[i] = k;
+        pos[i] = 0;
+        len[i] = spda_len(arrays[i]);
+    }
+    for (size_t i = k; i-- > 0;) _lt_adjust(&lt, tree, i);
+
+    char *dst = out;
+    for (size_t n = 0; n < total; ++n)
+    {
+        size_t w = tree[0];
+        memcpy(dst, (const char *)arrays[w] + pos[w] * stride, stride);
+        dst += stride;
+        pos[w]++;
+        _lt_adjust(&lt, tree, w);
+    }
+
+    free(scratch);
+    spda_set_length(out, total);
+    return out;
+}
@@ -0,0 +1,48 @@
+/*
+**  @brief: Set operations and k-way merge on sorted spda arrays **
+*   @Author: Samarth Pyati
+*   @Date : 19-10-2026
+*   @Version : 1.0
+*/
+
+#ifndef SPDA_SET_H_
+#define SPDA_SET_H_
+
+#include <stddef.h>         // size_t
+#include "spda.h"
+
+/*
+** Sorted Set Operations **
+* Inputs must be sorted by `compar` (the same comparator spda_sort takes) and
+* share the same stride. The set operations treat each input as a set of
+* distinct keys; spda_merge and spda_merge_k keep duplicates and are stable
+* (on equal keys, elements of earlier inputs come first).
+*
+* Every two-way operation is a single linear pass and returns a new array.
+*
+* spda_intersect_int is the integer fast path: when one side is much smaller
+* it gallops (exponential + binary search) through the larger side, otherwise
+* it scans with SSE2 block compares where available.
+*
+* spda_merge_k merges `k` sorted arrays through a loser tree (log2(k)
+* comparisons per element) into `out`, which should be reserved for the total
+* length up front. It is grown if it is not; the (possibly moved) array is
+* returned.
+*/
+
+typedef int (*SpdaCompar)(const void *, const void *);
+
+/* Two-way Operations */
+void *spda_merge(const void *a, const void *b, SpdaCompar compar);
+void *spda_union(const void *a, const void *b, SpdaCompar compar);
+void *spda_intersect(const void *a, const void *b, SpdaCompar compar);
+void *spda_difference(const void *a, const void *b, SpdaCompar compar);       // a \ b
+void *spda_symdiff(const void *a, const void *b, SpdaCompar compar);
+
+/* Integer Fast Paths */
+int *spda_intersect_int(const int *a, const int *b);
+
+/* K-way Merge */
+void *spda_merge_k(void *out, const void *const *arrays, size_t k, SpdaCompar compar);
+
+#endif // SPDA_SET_H_
@@ -0,0 +1,518 @@
+#define _GNU_SOURCE                 // memfd_create, shm_open, kill under -std=c17
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>                 // kill (before spda.h, which defines the raise macro)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "spda_shm.h"
+
+#if defined(SPDA_DEBUG) && defined(__SANITIZE_ADDRESS__)
+#include <sanitizer/asan_interface.h>
+#endif
+
+#define SPDA_SHM_MAGIC 0x314D485341445053ULL   // "SPDASHM1"
+
+_Static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Shared arrays need lock-free (address free) 64 bit atomics");
+
+/* Lives at offset 0 of the shared object: sizes and counters only, no pointers */
+struct SpdaShmRegion {
+    _Atomic uint64_t magic;         // SPDA_SHM_MAGIC once the header is initialised
+    uint64_t stride;
+    uint64_t reserve;               // bytes of address space every attachment maps
+    _Atomic uint64_t seq;           // seqlock, odd while the writer updates
+    _Atomic uint64_t length;
+    _Atomic uint64_t capacity;      // elements backed by the object
+    _Atomic int64_t writer;         // pid holding the writer role, 0 if none
+};
+
+_Static_assert(offsetof(SpdaShmRegion, seq) == SPDA_SHM_SEQ_OFFSET, "SPDA_SHM_SEQ_OFFSET does not match the region layout");
+
+/* The spda header sits right before the elements, so the data pointer is a spda array */
+#define SHM_SPDA_HEADER_SIZE (FIELD_COUNT * sizeof(size_t))
+
+_Static_assert(sizeof(SpdaShmRegion) + SHM_SPDA_HEADER_SIZE <= SPDA_SHM_DATA_OFFSET, "Shared header overlaps the elements");
+
+/* Debug builds expect a guard zone after capacity, so the object is backed that far */
+#ifdef SPDA_DEBUG
+#define SHM_GUARD SPDA_GUARD_SIZE
+#else
+#define SHM_GUARD 0
+#endif
+
+static inline size_t *_shm_spda_header(SpdaShmRegion *r)
+{
+    return (size_t *)((char *)r + SPDA_SHM_DATA_OFFSET) - FIELD_COUNT;
+}
+
+static inline size_t _shm_backed_size(size_t capacity, size_t stride)
+{
+    return SPDA_SHM_DATA_OFFSET + capacity * stride + SHM_GUARD;
+}
+
+static void _shm_arm_guard(SpdaShmRegion *r, size_t capacity)
+{
+#ifdef SPDA_DEBUG
+    unsigned char *guard = (unsigned char *)r + SPDA_SHM_DATA_OFFSET + capacity * r->stride;
+#if defined(__SANITIZE_ADDRESS__)
+    ASAN_UNPOISON_MEMORY_REGION(guard, SPDA_GUARD_SIZE);
+#endif
+    memset(guard, SPDA_GUARD_BYTE, SPDA_GUARD_SIZE);
+#else
+    (void)r, (void)capacity;
+#endif
+}
+
+/*
+* The debug checks poison the guard in this process's ASan shadow, but in a
+* shared array the guard moves when another process grows it. Let the
+* elements up to the current capacity be read again.
+*/
+static inline void _shm_unpoison(const SpdaShm *shm, size_t capacity)
+{
+#if defined(SPDA_DEBUG) && defined(__SANITIZE_ADDRESS__)
+    ASAN_UNPOISON_MEMORY_REGION(shm->data, capacity * shm->region->stride);
+#else
+    (void)shm, (void)capacity;
+#endif
+}
+
+/* ------------------------------------------------------------------------- */
+/*                                 SEQLOCK                                   */
+/* ------------------------------------------------------------------------- */
+
+static inline uint64_t _shm_write_begin(SpdaShmRegion *r)
+{
+    uint64_t s = atomic_load_explicit(&r->seq, memory_order_relaxed);
+    atomic_store_explicit(&r->seq, s + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    return s;
+}
+
+static inline void _shm_write_end(SpdaShmRegion *r, uint64_t s)
+{
+    atomic_store_explicit(&r->seq, s + 2, memory_order_release);
+}
+
+/*
+* Also mirrors the pair into the spda header. Those are plain words read by
+* spda_len, so the length is stored last with release: a reader going
+* through the spda API sees a length whose elements are written, though not
+* a seqlock-consistent pair.
+*/
+static inline void _shm_publish(SpdaShmRegion *r, size_t length, size_t capacity)
+{
+    uint64_t s = _shm_write_begin(r);
+    atomic_store_explicit(&r->length, length, memory_order_relaxed);
+    atomic_store_explicit(&r->capacity, capacity, memory_order_relaxed);
+
+    size_t *header = _shm_spda_header(r);
+    __atomic_store_n(&header[CAPACITY], capacity, __ATOMIC_RELAXED);
+    __atomic_store_n(&header[LENGTH], length, __ATOMIC_RELEASE);
+    _shm_write_end(r, s);
+}
+
+static inline void _shm_read(const SpdaShmRegion *r, size_t *length, size_t *capacity)
+{
+    uint64_t s1, s2;
+    do {
+        s1 = atomic_load_explicit(&r->seq, memory_order_acquire);
+        *length = atomic_load_explicit(&r->length, memory_order_relaxed);
+        *capacity = atomic_load_explicit(&r->capacity, memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+        s2 = atomic_load_explicit(&r->seq, memory_order_relaxed);
+    } while ((s1 & 1) || s1 != s2);
+}
+
+/* ------------------------------------------------------------------------- */
+/*                                LIFECYCLE                                  */
+/* ------------------------------------------------------------------------- */
+
+static size_t _shm_page_round(size_t bytes)
+{
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    return (bytes + page - 1) / page * page;
+}
+
+static bool _shm_claim_writer(SpdaShmRegion *r)
+{
+    int64_t self = (int64_t)getpid();
+    int64_t holder = atomic_load(&r->writer);
+    for (;;)
+    {
+        /* A holder that died without detaching gives the role up */
+        bool holder_live = holder != 0 && !(kill((pid_t)holder, 0) != 0 && errno == ESRCH);
+        if (holder_live) {
+            raise("SHM_BUSY", "Shared array already has a live writer");
+            return false;
+        }
+        if (atomic_compare_exchange_weak(&r->writer, &holder, self)) break;
+    }
+
+    /*
+    * A writer killed inside a seqlock section leaves `seq` odd, which would
+    * keep readers spinning and flip the parity of every later section.
+    * Nobody else can write now, so close the section it left open.
+    */
+    uint64_t s = atomic_load_explicit(&r->seq, memory_order_relaxed);
+    if (s & 1) atomic_store_explicit(&r->seq, s + 1, memory_order_release);
+    return true;
+}
+
+/* Map an initialised object (writable or not); takes ownership of `fd` */
+static SpdaShm *_shm_map(int fd, bool writable)
+{
+    /* A creator that has not run ftruncate yet leaves a zero length object: touching it is SIGBUS */
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)SPDA_SHM_DATA_OFFSET) {
+        raise("INVALID_SOURCE", "Shared memory object is not an initialised spda array");
+        close(fd);
+        return NULL;
+    }
+    SpdaShmRegion *probe = mmap(NULL, SPDA_SHM_DATA_OFFSET, PROT_READ, MAP_SHARED, fd, 0);
+    if (probe == MAP_FAILED) {
+        raise("SHM_MAP", "Failed to map the shared array header");
+        close(fd);
+        return NULL;
+    }
+    bool valid = atomic_load_explicit(&probe->magic, memory_order_acquire) == SPDA_SHM_MAGIC;
+    size_t reserve = probe->reserve;
+    munmap(probe, SPDA_SHM_DATA_OFFSET);
+    if (!valid) {
+        raise("INVALID_SOURCE", "Shared memory object is not an initialised spda array");
+        close(fd);
+        return NULL;
+    }
+
+    SpdaShm *shm = malloc(sizeof(SpdaShm));
+    void *base = mmap(NULL, reserve, PROT_READ | (writable ? PROT_WRITE : 0), MAP_SHARED, fd, 0);
+    if (shm == NULL || base == MAP_FAILED) {
+        raise("SHM_MAP", "Failed to map the shared array");
+        if (base != MAP_FAILED) munmap(base, reserve);
+        free(shm);
+        close(fd);
+        return NULL;
+    }
+
+    shm->region = base;
+    shm->data = (char *)base + SPDA_SHM_DATA_OFFSET;
+    shm->reserve = reserve;
+    shm->fd = fd;
+    shm->writer = false;
+    return shm;
+}
+
+static SpdaShm *_shm_attach(int fd, bool writer)
+{
+    SpdaShm *shm = _shm_map(fd, writer);
+    if (shm == NULL || !writer) return shm;
+    if (!_shm_claim_writer(shm->region)) {
+        spda_shm_detach(shm);
+        return NULL;
+    }
+    shm->writer = true;
+    return shm;
+}
+
+static int _shm_open_new(const char *name)
+{
+    if (name) return shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+
+#if defined(__linux__)
+    return memfd_create("spda_shm", MFD_CLOEXEC);
+#else
+    /* No memfd: a private name that is unlinked right away */
+    char tmp[64];
+    snprintf(tmp, sizeof(tmp), "/spda_shm_%ld_%p", (long)getpid(), (void *)tmp);
+    int fd = shm_open(tmp, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd >= 0) shm_unlink(tmp);
+    return fd;
+#endif
+}
+
+SpdaShm *spda_shm_create(const char *name, size_t stride, size_t capacity, size_t reserve)
+{
+    if (stride == 0) {
+        raise("INVALID_ARGUMENT", "Stride (size of datatype) cannot be zero");
+        return NULL;
+    }
+    if (capacity < SPDA_DEFAULT_CAPACITY) capacity = SPDA_DEFAULT_CAPACITY;
+    reserve = _shm_page_round(reserve ? reserve : SPDA_SHM_DEFAULT_RESERVE);
+    if (reserve <= SPDA_SHM_DATA_OFFSET + SHM_GUARD || capacity > (reserve - SPDA_SHM_DATA_OFFSET - SHM_GUARD) / stride) {
+        raise("INVALID_ARGUMENT", "Initial capacity does not fit the reserved address space");
+        return NULL;
+    }
+
+    int fd = _shm_open_new(name);
+    if (fd < 0) {
+        raise("SHM_OPEN", "Failed to create the shared memory object");
+        return NULL;
+    }
+    SpdaShmRegion *r = MAP_FAILED;
+    if (ftruncate(fd, (off_t)_shm_backed_size(capacity, stride)) != 0
+        || (r = mmap(NULL, SPDA_SHM_DATA_OFFSET, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED) {
+        raise("SHM_OPEN", "Failed to size the shared memory object");
+        close(fd);
+        if (name) shm_unlink(name);
+        return NULL;
+    }
+
+    r->stride = stride;
+    r->reserve = reserve;
+    atomic_init(&r->seq, 0);
+    atomic_init(&r->length, 0);
+    atomic_init(&r->capacity, capacity);
+    atomic_init(&r->writer, (int64_t)getpid());
+
+    size_t *header = _shm_spda_header(r);
+    header[CAPACITY] = capacity;
+    header[LENGTH] = 0;
+    header[STRIDE] = stride;
+#ifdef SPDA_DEBUG
+    header[GENERATION] = 0;
+    header[MAGIC] = SPDA_MAGIC;
+#endif
+    atomic_store_explicit(&r->magic, SPDA_SHM_MAGIC, memory_order_release);
+    munmap(r, SPDA_SHM_DATA_OFFSET);
+
+    /* The header already names us as the writer */
+    SpdaShm *shm = _shm_map(fd, true);
+    if (shm == NULL) {
+        if (name) shm_unlink(name);
+        return NULL;
+    }
+    shm->writer = true;
+    _shm_arm_guard(shm->region, capacity);
+    return shm;
+}
+
+SpdaShm *spda_shm_attach(const char *name, bool writer)
+{
+    if (!name) {
+        raise("INVALID_ARGUMENT", "Shared array name cannot be NULL");
+        return NULL;
+    }
+    int fd = shm_open(name, writer ? O_RDWR : O_RDONLY, 0);
+    if (fd < 0) {
+        raise("SHM_OPEN", "Failed to open the shared memory object");
+        return NULL;
+    }
+    return _shm_attach(fd, writer);
+}
+
+SpdaShm *spda_shm_attach_fd(int fd, bool writer)
+{
+    int own = dup(fd);
+    if (own < 0) {
+        raise("SHM_OPEN", "Failed to duplicate the shared memory descriptor");
+        return NULL;
+    }
+    return _shm_attach(own, writer);
+}
+
+void spda_shm_detach(SpdaShm *shm)
+{
+    if (!shm) return;
+    if (shm->writer) {
+        int64_t self = (int64_t)getpid();
+        atomic_compare_exchange_strong(&shm->region->writer, &self, 0);
+    }
+    munmap(shm->region, shm->reserve);
+    close(shm->fd);
+    free(shm);
+}
+
+bool spda_shm_unlink(const char *name)
+{
+    if (!name || shm_unlink(name) != 0) {
+        raise("SHM_OPEN", "Failed to unlink the shared memory object");
+        return false;
+    }
+    return true;
+}
+
+/* ------------------------------------------------------------------------- */
+/*                                 READING                                   */
+/* ------------------------------------------------------------------------- */
+
+size_t spda_shm_len(const SpdaShm *shm)
+{
+    size_t length, capacity;
+    _shm_read(shm->region, &length, &capacity);
+    _shm_unpoison(shm, capacity);
+    return length;
+}
+
+size_t spda_shm_cap(const SpdaShm *shm)
+{
+    size_t length, capacity;
+    _shm_read(shm->region, &length, &capacity);
+    return capacity;
+}
+
+size_t spda_shm_stride(const SpdaShm *shm)
+{
+    return shm->region->stride;
+}
+
+void *spda_shm_data(const SpdaShm *shm)
+{
+    _shm_unpoison(shm, spda_shm_cap(shm));
+    return shm->data;
+}
+
+void *spda_shm_snapshot(const SpdaShm *shm)
+{
+    if (!shm) {
+        raise("INVALID_SOURCE", "Source shared array cannot be NULL");
+        return NULL;
+    }
+
+    const SpdaShmRegion *r = shm->region;
+    size_t stride = r->stride;
+    void *array = NULL;
+    for (;;)
+    {
+        uint64_t s1 = atomic_load_explicit(&r->seq, memory_order_acquire);
+        if (s1 & 1) continue;
+        size_t length = atomic_load_explicit(&r->length, memory_order_relaxed);
+
+        if (array == NULL || spda_cap(array) < length) {
+            spda_destroy(array);
+            array = _spda_create(length, stride);
+            if (array == NULL) return NULL;
+        }
+        memcpy(array, shm->data, length * stride);
+
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&r->seq, memory_order_relaxed) == s1) {
+            spda_set_length(array, length);
+            return array;
+        }
+    }
+}
+
+/* ------------------------------------------------------------------------- */
+/*                                 WRITING                                   */
+/* ------------------------------------------------------------------------- */
+
+static bool _shm_check_writer(const SpdaShm *shm)
+{
+    if (!shm || !shm->writer) {
+        raise("INVALID_ARGUMENT", "Only the writer attachment can modify a shared array");
+        return false;
+    }
+    return true;
+}
+
+bool spda_shm_reserve(SpdaShm *shm, size_t capacity)
+{
+    if (!_shm_check_writer(shm)) return false;
+
+    SpdaShmRegion *r = shm->region;
+    size_t current = atomic_load_explicit(&r->capacity, memory_order_relaxed);
+    if (capacity <= current) return true;
+
+    size_t max_cap = (shm->reserve - SPDA_SHM_DATA_OFFSET - SHM_GUARD) / r->stride;
+    if (capacity > max_cap) {
+        raise("MEM_ALLOCATION", "Shared array capacity exceeds its reserved address space");
+        return false;
+    }
+    size_t new_cap = current * SPDA_GROWTH_FACTOR;
+    if (new_cap < capacity) new_cap = capacity;
+    if (new_cap > max_cap) new_cap = max_cap;
+
+    /* Extend the object first: nobody may see a capacity that is not backed yet */
+    if (ftruncate(shm->fd, (off_t)_shm_backed_size(new_cap, r->stride)) != 0) {
+        raise("MEM_ALLOCATION", "Failed to extend the shared memory object");
+        return false;
+    }
+    _shm_unpoison(shm, new_cap);
+    _shm_arm_guard(r, new_cap);
+    _shm_publish(r, atomic_load_explicit(&r->length, memory_order_relaxed), new_cap);
+    return true;
+}
+
+bool spda_shm_append(SpdaShm *shm, const void *value)
+{
+    return spda_shm_append_many(shm, value, 1);
+}
+
+bool spda_shm_append_many(SpdaShm *shm, const void *items, size_t count)
+{
+    if (!_shm_check_writer(shm) || (!items && count > 0)) return false;
+
+    SpdaShmRegion *r = shm->region;
+    size_t length = atomic_load_explicit(&r->length, memory_order_relaxed);
+    if (!spda_shm_reserve(shm, length + count)) return false;
+
+    /* Past the published length nobody is reading, so no need to hold the seqlock */
+    memcpy((char *)shm->data + length * r->stride, items, count * r->stride);
+    _shm_publish(r, length + count, atomic_load_explicit(&r->capacity, memory_order_relaxed));
+    return true;
+}
+
+bool spda_shm_publish(SpdaShm *shm, size_t length)
+{
+    if (!_shm_check_writer(shm)) return false;
+
+    SpdaShmRegion *r = shm->region;
+    size_t capacity = atomic_load_explicit(&r->capacity, memory_order_relaxed);
+    if (length > capacity) {
+        raise("INDEX_OUT_OF_BOUNDS", "Published length exceeds the shared array capacity");
+        return false;
+    }
+    _shm_publish(r, length, capacity);
+    return true;
+}
+
+bool spda_shm_set(SpdaShm *shm, size_t idx, const void *value)
+{
+    if (!_shm_check_writer(shm) || !value) return false;
+
+    SpdaShmRegion *r = shm->region;
+    if (idx >= atomic_load_explicit(&r->length, memory_order_relaxed)) {
+        raise("INDEX_OUT_OF_BOUNDS", "Index out of bounds for shared array set");
+        return false;
+    }
+    uint64_t s = _shm_write_begin(r);
+    memcpy((char *)shm->data + idx * r->stride, value, r->stride);
+    _shm_write_end(r, s);
+    return true;
+}
+
+bool spda_shm_truncate(SpdaShm *shm, size_t length)
+{
+    if (!_shm_check_writer(shm)) return false;
+
+    SpdaShmRegion *r = shm->region;
+    if (length > atomic_load_explicit(&r->length, memory_order_relaxed)) {
+        raise("INDEX_OUT_OF_BOUNDS", "Truncating a shared array cannot grow it");
+        return false;
+    }
+    _shm_publish(r, length, atomic_load_explicit(&r->capacity, memory_order_relaxed));
+    return true;
+}
+
+SpdaShm *spda_shm_from(const char *name, const void *array, size_t reserve)
+{
+    if (!array) {
+        raise("INVALID_SOURCE", "Source array cannot be NULL");
+        return NULL;
+    }
+
+    size_t length = spda_len(array);
+    SpdaShm *shm = spda_shm_create(name, spda_stride(array), length, reserve);
+    if (shm == NULL) return NULL;
+    if (!spda_shm_append_many(shm, array, length)) {
+        spda_shm_detach(shm);
+        if (name) shm_unlink(name);
+        return NULL;
+    }
+    return shm;
+}
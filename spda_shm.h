@@ -0,0 +1,101 @@
+/*
+**  @brief: Shared-memory spda arrays for zero-copy exchange between processes **
+*   @Author: Samarth Pyati
+*   @Date : 19-10-2026
+*   @Version : 1.0
+*/
+
+#ifndef SPDA_SHM_H_
+#define SPDA_SHM_H_
+
+#include <stddef.h>         // size_t
+#include <stdbool.h>        // bool
+#include "spda.h"
+
+/*
+** Shared Memory Layout **
+* The array lives in a POSIX shared memory object (shm_open) or an anonymous
+* memfd. The region header holds sizes and counters only, never pointers, so
+* every process can map it at a different address:
+*
+*   offset 0                               SPDA_SHM_DATA_OFFSET
+*   +------------------------+------------+----------------------------+ - - - - - +
+*   | magic | stride | ...   | spda header|         elements           | unbacked  |
+*   | seq | length | writer  | cap|len|str|  (capacity * stride bytes) |  reserve  |
+*   +------------------------+------------+----------------------------+ - - - - - +
+*
+* A regular spda header sits right before the elements, so spda_shm_data is
+* a spda array in every process: pass it to spda_len, spda_print, spda_write,
+* spda_copy and the other functions that do not modify or free the array.
+* It is read-only (readers map it PROT_READ); change it only through the
+* spda_shm_* writer functions below. Debug builds (-DSPDA_DEBUG) also keep
+* the guard zone after capacity, so every process must share the build mode.
+*
+* Every process maps `reserve` bytes of address space up front, while the
+* object itself is only ftruncate'd to what the capacity needs. Growing the
+* array extends the object and publishes the new capacity, so other
+* processes see the growth without remapping and their data pointers stay
+* valid. `reserve` bounds the capacity.
+*
+** Single Writer, Many Readers **
+* One attachment may write. It fills elements past the published length
+* (append, or reserve + write into spda_shm_data + spda_shm_publish) and then
+* publishes the new length under a seqlock: `seq` is odd while length and
+* capacity change. Readers retry until they see the same even `seq` on both
+* sides of their read, so they never see a length without its elements.
+* The spda header is updated in the same section, length last, so spda_len
+* on the data never runs ahead of the elements either.
+* Elements below the length are read in place. spda_shm_set and
+* spda_shm_truncate rewrite published elements inside the seqlock, and
+* spda_shm_snapshot takes a consistent copy even then.
+*
+** Lifecycle **
+* spda_shm_create makes a new object (named, or an anonymous memfd when
+* `name` is NULL) and attaches as its writer. spda_shm_attach or
+* spda_shm_attach_fd map an existing one as a reader or writer. The writer
+* role is refused while another live process holds it. Attaching to a name
+* whose creator has not finished initialising it fails with INVALID_SOURCE,
+* so retry until it succeeds. spda_shm_detach unmaps and releases the role,
+* and spda_shm_unlink removes the name once everyone has attached.
+*/
+
+#define SPDA_SHM_DATA_OFFSET 4096
+#define SPDA_SHM_SEQ_OFFSET 24                       // region byte offset of the seqlock counter
+#define SPDA_SHM_DEFAULT_RESERVE ((size_t)1 << 30)   // 1 GiB of address space
+
+typedef struct SpdaShmRegion SpdaShmRegion;
+
+typedef struct {
+    SpdaShmRegion *region;      // start of this process's mapping
+    void *data;                 // read-only spda array, SPDA_SHM_DATA_OFFSET into the mapping
+    size_t reserve;             // bytes mapped
+    int fd;
+    bool writer;
+} SpdaShm;
+
+/* Lifecycle */
+SpdaShm *spda_shm_create(const char *name, size_t stride, size_t capacity, size_t reserve);
+SpdaShm *spda_shm_attach(const char *name, bool writer);
+SpdaShm *spda_shm_attach_fd(int fd, bool writer);
+void spda_shm_detach(SpdaShm *shm);
+bool spda_shm_unlink(const char *name);
+
+/* Reading (any attachment) */
+size_t spda_shm_len(const SpdaShm *shm);                                // seqlock-consistent length
+size_t spda_shm_cap(const SpdaShm *shm);
+size_t spda_shm_stride(const SpdaShm *shm);
+void *spda_shm_data(const SpdaShm *shm);                                // read-only spda array view
+void *spda_shm_snapshot(const SpdaShm *shm);                            // consistent copy as a spda array
+
+/* Writing (writer only) */
+bool spda_shm_reserve(SpdaShm *shm, size_t capacity);
+bool spda_shm_append(SpdaShm *shm, const void *value);
+bool spda_shm_append_many(SpdaShm *shm, const void *items, size_t count);
+bool spda_shm_publish(SpdaShm *shm, size_t length);                     // after writing into spda_shm_data
+bool spda_shm_set(SpdaShm *shm, size_t idx, const void *value);
+bool spda_shm_truncate(SpdaShm *shm, size_t length);
+
+/* Copy a spda array into a new shared array */
+SpdaShm *spda_shm_from(const char *name, const void *array, size_t reserve);
+
+#endif // SPDA_SHM_H_
@@ -0,0 +1,322 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdint.h>
+#include "spda_str.h"
+#include "spda_typed.h"
+
+#define SPDA_STRS_TABLE_MIN 16
+
+SPDA_DEFINE(_spda_offsets, size_t)
+
+/*
+* Sort key: the first 8 bytes of the string packed big endian, so most
+* comparisons are a single integer compare that never touches the bytes.
+*/
+typedef struct {
+    uint64_t prefix;
+    const char *str;
+} StrKey;
+
+static inline bool _strkey_less(StrKey a, StrKey b)
+{
+    if (a.prefix != b.prefix) return a.prefix < b.prefix;
+    /* A zero low byte means both strings ended inside the prefix: they are equal */
+    if ((a.prefix & 0xFF) == 0) return false;
+    return strcmp(a.str + 8, b.str + 8) < 0;
+}
+
+#define STRKEY_LESS(a, b) _strkey_less((a), (b))
+SPDA_DEFINE(_spda_strkeys, StrKey)
+SPDA_DEFINE_SORT(_spda_strkeys, StrKey, STRKEY_LESS)
+
+static inline uint64_t _strs_prefix(const char *s)
+{
+    uint64_t prefix = 0;
+    for (int i = 0; i < 8 && s[i]; ++i) prefix |= (uint64_t)(unsigned char)s[i] << (56 - 8 * i);
+    return prefix;
+}
+
+/* FNV-1a */
+static inline uint64_t _strs_hash(const char *s, size_t n)
+{
+    uint64_t h = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < n; ++i) {
+        h ^= (unsigned char)s[i];
+        h *= 0x100000001B3ULL;
+    }
+    return h;
+}
+
+/* ------------------------------------------------------------------------- */
+/*                               INTERNING                                   */
+/* ------------------------------------------------------------------------- */
+
+/* Stored string equals s[0..n); never reads past the stored terminator */
+static inline bool _strs_equal(const char *stored, const char *s, size_t n)
+{
+    size_t i = 0;
+    while (i < n && stored[i] != '\0' && stored[i] == s[i]) ++i;
+    return i == n && stored[n] == '\0';
+}
+
+/* Slot holding `s` (table entry != 0) or the empty slot where it belongs */
+static size_t _strs_probe(const SpdaStrs *strs, const char *s, size_t n, uint64_t hash)
+{
+    size_t mask = spda_len(strs->table) - 1;
+    for (size_t slot = hash & mask;; slot = (slot + 1) & mask)
+    {
+        size_t entry = strs->table[slot];
+        if (entry == 0) return slot;
+        const char *stored = strs->bytes + strs->offsets[entry - 1];
+        if (_strs_equal(stored, s, n)) return slot;
+    }
+}
+
+static bool _strs_table_rebuild(SpdaStrs *strs, size_t slots)
+{
+    size_t *table = spda_reserve(size_t, slots);
+    if (table == NULL) return false;
+    memset(table, 0, slots * sizeof(size_t));
+    spda_set_length(table, slots);
+
+    spda_destroy(strs->table);
+    strs->table = table;
+    for (size_t i = 0; i < spda_strs_len(strs); ++i)
+    {
+        /* push_n cuts interned strings at their first NUL, so strlen is their stored length */
+        const char *s = strs->bytes + strs->offsets[i];
+        size_t n = strlen(s);
+        strs->table[_strs_probe(strs, s, n, _strs_hash(s, n))] = i + 1;
+    }
+    return true;
+}
+
+/* ------------------------------------------------------------------------- */
+/*                               PUBLIC API                                  */
+/* ------------------------------------------------------------------------- */
+
+SpdaStrs *spda_strs_create(bool intern)
+{
+    SpdaStrs *strs = malloc(sizeof(SpdaStrs));
+    if (strs == NULL) {
+        raise("MEM_ALLOCATION", "Failed to allocate string array");
+        return NULL;
+    }
+
+    strs->bytes = spda_create(char);
+    strs->offsets = spda_create(size_t);
+    strs->table = NULL;
+    strs->sorted = true;
+    if (!strs->bytes || !strs->offsets || (intern && !_strs_table_rebuild(strs, SPDA_STRS_TABLE_MIN))) {
+        spda_strs_destroy(strs);
+        return NULL;
+    }
+    return strs;
+}
+
+void spda_strs_destroy(SpdaStrs *strs)
+{
+    if (!strs) return;
+    spda_destroy(strs->bytes);
+    spda_destroy(strs->offsets);
+    spda_destroy(strs->table);
+    free(strs);
+}
+
+size_t spda_strs_len(const SpdaStrs *strs)
+{
+    return _spda_offsets_len(strs->offsets);
+}
+
+const char *spda_strs_get(const SpdaStrs *strs, size_t idx)
+{
+    if (idx >= spda_strs_len(strs)) {
+        raise("INDEX_OUT_OF_BOUNDS", "Index out of bounds for string access");
+        return NULL;
+    }
+    return strs->bytes + strs->offsets[idx];
+}
+
+size_t spda_strs_push(SpdaStrs *strs, const char *s)
+{
+    return spda_strs_push_n(strs, s, strlen(s));
+}
+
+size_t spda_strs_push_n(SpdaStrs *strs, const char *s, size_t n)
+{
+    if (!strs || !s) {
+        raise("INVALID_ARGUMENT", "Invalid string array or string");
+        return SPDA_STRS_NPOS;
+    }
+
+    size_t slot = 0;
+    uint64_t hash = 0;
+    if (strs->table) {
+        /* An interned string ends at its first NUL: the same bytes a table rebuild hashes */
+        const char *nul = memchr(s, '\0', n);
+        if (nul) n = (size_t)(nul - s);
+        hash = _strs_hash(s, n);
+        slot = _strs_probe(strs, s, n, hash);
+        if (strs->table[slot] != 0) return strs->table[slot] - 1;
+    }
+
+    /* `s` may point into our own buffer, which is about to move */
+    size_t length = spda_char_len(strs->bytes);
+    bool aliased = s >= strs->bytes && s < strs->bytes + length;
+    size_t alias_offset = aliased ? (size_t)(s - strs->bytes) : 0;
+
+    strs->bytes = spda_char_grow(strs->bytes, n + 1);
+    strs->offsets = _spda_offsets_grow(strs->offsets, 1);
+    if (spda_char_cap(strs->bytes) < length + n + 1 || _spda_offsets_cap(strs->offsets) <= spda_strs_len(strs))
+        return SPDA_STRS_NPOS;
+    if (aliased) s = strs->bytes + alias_offset;
+
+    char *dst = strs->bytes + length;
+    memcpy(dst, s, n);
+    dst[n] = '\0';
+    spda_set_length(strs->bytes, length + n + 1);
+
+    size_t idx = spda_strs_len(strs);
+    if (strs->sorted && idx > 0 && strcmp(spda_strs_get(strs, idx - 1), dst) > 0) strs->sorted = false;
+    strs->offsets = _spda_offsets_append(strs->offsets, length);
+
+    if (strs->table) {
+        strs->table[slot] = idx + 1;
+        /* Keep the load factor under 1/2 */
+        if (2 * (idx + 1) > spda_len(strs->table)) _strs_table_rebuild(strs, 2 * spda_len(strs->table));
+    }
+    return idx;
+}
+
+size_t spda_strs_bytes(const SpdaStrs *strs)
+{
+    size_t header = FIELD_COUNT * sizeof(size_t);
+    size_t total = sizeof(SpdaStrs) + 2 * header
+                 + spda_char_cap(strs->bytes) + _spda_offsets_cap(strs->offsets) * sizeof(size_t);
+    if (strs->table) total += header + spda_cap(strs->table) * sizeof(size_t);
+    return total;
+}
+
+void spda_strs_sort(SpdaStrs *strs)
+{
+    size_t n = spda_strs_len(strs);
+    StrKey *keys = _spda_strkeys_reserve(n);
+    if (keys == NULL) return;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        const char *s = strs->bytes + strs->offsets[i];
+        keys = _spda_strkeys_append(keys, (StrKey){ .prefix = _strs_prefix(s), .str = s });
+    }
+    _spda_strkeys_sort(keys);
+
+    for (size_t i = 0; i < n; ++i) strs->offsets[i] = (size_t)(keys[i].str - strs->bytes);
+    _spda_strkeys_destroy(keys);
+    strs->sorted = true;
+
+    /* Interned indices moved with the strings */
+    if (strs->table) _strs_table_rebuild(strs, spda_len(strs->table));
+}
+
+size_t spda_strs_find(const SpdaStrs *strs, const char *key)
+{
+    if (!strs || !key) return SPDA_STRS_NPOS;
+
+    if (strs->table) {
+        size_t n = strlen(key);
+        size_t entry = strs->table[_strs_probe(strs, key, n, _strs_hash(key, n))];
+        return entry ? entry - 1 : SPDA_STRS_NPOS;
+    }
+
+    size_t count = spda_strs_len(strs);
+    if (!strs->sorted) {
+        for (size_t i = 0; i < count; ++i)
+            if (strcmp(strs->bytes + strs->offsets[i], key) == 0) return i;
+        return SPDA_STRS_NPOS;
+    }
+
+    size_t lo = 0, hi = count;
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        if (strcmp(strs->bytes + strs->offsets[mid], key) < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo < count && strcmp(strs->bytes + strs->offsets[lo], key) == 0 ? lo : SPDA_STRS_NPOS;
+}
+
+size_t spda_strs_load(SpdaStrs *strs, const char *text, size_t size)
+{
+    if (!strs || (!text && size > 0)) {
+        raise("INVALID_ARGUMENT", "Invalid string array or text");
+        return 0;
+    }
+    if (size == 0) return 0;
+
+    size_t before = spda_strs_len(strs);
+    if (strs->table) {
+        /* Interning has to look at every line on its own */
+        const char *end = text + size;
+        while (text < end)
+        {
+            const char *nl = memchr(text, '\n', end - text);
+            size_t n = (nl ? nl : end) - text;
+            spda_strs_push_n(strs, text, n > 0 && text[n - 1] == '\r' ? n - 1 : n);
+            text += n + 1;
+        }
+        return spda_strs_len(strs) - before;
+    }
+
+    /* Copy the whole text once, then turn the newlines into terminators in place */
+    size_t base = spda_char_len(strs->bytes);
+    strs->bytes = spda_char_grow(strs->bytes, size + 1);
+    if (spda_char_cap(strs->bytes) < base + size + 1) return 0;
+    char *bytes = strs->bytes;
+    memcpy(bytes + base, text, size);
+    bytes[base + size] = '\0';
+
+    size_t pos = base, end = base + size;
+    while (pos < end)
+    {
+        char *nl = memchr(bytes + pos, '\n', end - pos);
+        size_t line_end = nl ? (size_t)(nl - bytes) : end;
+        bytes[line_end] = '\0';
+        if (line_end > pos && bytes[line_end - 1] == '\r') bytes[line_end - 1] = '\0';
+
+        strs->offsets = _spda_offsets_append(strs->offsets, pos);
+        pos = line_end + 1;
+    }
+    spda_set_length(strs->bytes, size > 0 && text[size - 1] == '\n' ? end : end + 1);
+
+    if (spda_strs_len(strs) > before) strs->sorted = false;
+    return spda_strs_len(strs) - before;
+}
+
+size_t spda_strs_load_file(SpdaStrs *strs, FILE *file)
+{
+    if (!file) {
+        raise("INVALID_SOURCE", "Source file cannot be NULL");
+        return 0;
+    }
+
+    char *text = spda_reserve(char, 1 << 16);
+    if (text == NULL) return 0;
+
+    size_t n;
+    for (;;)
+    {
+        size_t length = spda_char_len(text);
+        if (length == spda_char_cap(text)) {
+            text = spda_char_grow(text, length);
+            if (spda_char_cap(text) == length) break;
+        }
+        n = fread(text + length, 1, spda_char_cap(text) - length, file);
+        if (n == 0) break;
+        spda_set_length(text, length + n);
+    }
+
+    size_t added = spda_strs_load(strs, text, spda_len(text));
+    spda_destroy(text);
+    return added;
+}
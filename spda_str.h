@@ -0,0 +1,62 @@
+/*
+**  @brief: String arrays with contiguous (optionally interned) character storage **
+*   @Author: Samarth Pyati
+*   @Date : 19-10-2026
+*   @Version : 1.0
+*/
+
+#ifndef SPDA_STR_H_
+#define SPDA_STR_H_
+
+#include <stdio.h>          // FILE
+#include <stddef.h>         // size_t
+#include <stdbool.h>        // bool
+#include "spda.h"
+
+/*
+** String Array **
+* All characters live in one growable spda char buffer, every string NUL
+* terminated, and `offsets` holds where each string starts. Pushing a string
+* is an amortized memcpy instead of a malloc, destroying the array is three
+* frees and scans walk a single allocation.
+*
+*  bytes:    +-----------+-------------+-------+----
+*            | c a t \0  | z e b r a \0 | o x \0 | ...
+*            +-----------+-------------+-------+----
+*            ^            ^              ^
+*  offsets:  0            4              10
+*
+* Sorting reorders `offsets` only; the characters never move. With interning
+* enabled a hash table of string indices makes pushes of an already stored
+* string return the existing index instead of storing it again.
+*/
+
+#define SPDA_STRS_NPOS ((size_t)-1)
+
+typedef struct {
+    char *bytes;            // spda char array of NUL terminated strings
+    size_t *offsets;        // spda array, start of each string in `bytes`
+    size_t *table;          // interning hash table of (index + 1), NULL when not interning
+    bool sorted;            // offsets are in strcmp order (set by spda_strs_sort)
+} SpdaStrs;
+
+/* Creation and Destruction */
+SpdaStrs *spda_strs_create(bool intern);
+void spda_strs_destroy(SpdaStrs *strs);
+
+/* Element Operations */
+size_t spda_strs_push(SpdaStrs *strs, const char *s);                  // returns the index of `s`
+size_t spda_strs_push_n(SpdaStrs *strs, const char *s, size_t n);     // interning keeps s only up to a NUL
+const char *spda_strs_get(const SpdaStrs *strs, size_t idx);
+size_t spda_strs_len(const SpdaStrs *strs);
+size_t spda_strs_bytes(const SpdaStrs *strs);                          // heap footprint
+
+/* Sort and Search */
+void spda_strs_sort(SpdaStrs *strs);
+size_t spda_strs_find(const SpdaStrs *strs, const char *key);          // index or SPDA_STRS_NPOS
+
+/* Bulk Loading (newline delimited, trailing '\r' stripped) */
+size_t spda_strs_load(SpdaStrs *strs, const char *text, size_t size);  // returns strings added
+size_t spda_strs_load_file(SpdaStrs *strs, FILE *file);
+
+#endif // SPDA_STR_H_
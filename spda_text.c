@@ -0,0 +1,659 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include <unistd.h>
+#include "spda_text.h"
+#include "spda_typed.h"
+
+#define TWO_POW_53 9007199254740992.0
+
+static const char DIGITS2[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/* Every power of ten up to 1e22 is exact in a double */
+static const double POW10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+static size_t _text_stride(SpdaTextType type)
+{
+    return type == SPDA_TEXT_I32 || type == SPDA_TEXT_F32 ? 4 : 8;
+}
+
+static bool _text_check(const void *array, SpdaTextType type)
+{
+    if (!array) {
+        raise("INVALID_SOURCE", "Source array cannot be NULL");
+        return false;
+    }
+    if (spda_stride(array) != _text_stride(type)) {
+        raise("INVALID_ARGUMENT", "Array stride does not match the element type");
+        return false;
+    }
+    return true;
+}
+
+/* ------------------------------------------------------------------------- */
+/*                                FORMATTING                                 */
+/* ------------------------------------------------------------------------- */
+
+/* Writes `v` backwards ending at `end`, two digits per division; returns the start */
+static inline char *_fmt_u64(char *end, uint64_t v)
+{
+    while (v >= 100) {
+        unsigned r = (unsigned)(v % 100);
+        v /= 100;
+        end -= 2;
+        memcpy(end, DIGITS2 + 2 * r, 2);
+    }
+    if (v >= 10) {
+        end -= 2;
+        memcpy(end, DIGITS2 + 2 * v, 2);
+    } else {
+        *--end = (char)('0' + v);
+    }
+    return end;
+}
+
+size_t spda_format_int(char *out, long long value)
+{
+    char tmp[24];
+    char *end = tmp + sizeof(tmp);
+    uint64_t u = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+    char *p = _fmt_u64(end, u);
+    if (value < 0) *--p = '-';
+
+    size_t n = (size_t)(end - p);
+    memcpy(out, p, n);
+    out[n] = '\0';
+    return n;
+}
+
+/* m * 10^-k in fixed notation */
+static size_t _fmt_fixed(char *out, bool negative, uint64_t m, int k)
+{
+    char tmp[24];
+    char *end = tmp + sizeof(tmp);
+    char *digits = _fmt_u64(end, m);
+    size_t count = (size_t)(end - digits);
+    char *dst = out;
+
+    if (negative) *dst++ = '-';
+    if (count <= (size_t)k) {
+        *dst++ = '0';
+        *dst++ = '.';
+        for (size_t i = count; i < (size_t)k; ++i) *dst++ = '0';
+        memcpy(dst, digits, count);
+        dst += count;
+    } else {
+        size_t whole = count - (size_t)k;
+        memcpy(dst, digits, whole);
+        dst += whole;
+        if (k > 0) {
+            *dst++ = '.';
+            memcpy(dst, digits + whole, (size_t)k);
+            dst += k;
+        }
+    }
+    *dst = '\0';
+    return (size_t)(dst - out);
+}
+
+/*
+* Fewest fractional digits k such that some integer m gives m / 10^k back as
+* `x`, which holds exactly when m / 10^k lies in x's rounding interval (ends
+* included for an even mantissa, since parsing ties to even). With
+* x = f * 2^(e - 2) the interval ends are (4f - 2) and (4f + 2) in the same
+* units, or (4f - 1) below a power of two, and scaling them by 10^k stays
+* inside 128 bits for k <= 21. `bits` is the mantissa width (53 or 24).
+* Returns k, or -1 when x is too large for fixed notation.
+*/
+static int _shortest_fixed(double x, int bits, uint64_t *m_out)
+{
+    int e;
+    uint64_t f = (uint64_t)ldexp(frexp(x, &e), bits);
+    int shift = bits + 2 - e;
+    if (shift < 1) return -1;
+
+    bool even = (f & 1) == 0;
+    unsigned __int128 mid = (unsigned __int128)f << 2;
+    unsigned __int128 lo = mid - (f == (uint64_t)1 << (bits - 1) ? 1 : 2);
+    unsigned __int128 hi = mid + 2;
+    unsigned __int128 half = (unsigned __int128)1 << (shift - 1);
+    for (int k = 0; k <= 21; ++k, mid *= 10, lo *= 10, hi *= 10)
+    {
+        /* Try the nearest m first, then its neighbour on the other side of x */
+        unsigned __int128 down = mid >> shift;
+        if (down >= (uint64_t)1 << 62) break;
+        bool round_up = mid - (down << shift) >= half;
+        unsigned __int128 candidates[2] = { down + round_up, down + !round_up };
+        for (int c = 0; c < 2; ++c)
+        {
+            unsigned __int128 v = candidates[c] << shift;
+            if (even ? lo <= v && v <= hi : lo < v && v < hi) {
+                *m_out = (uint64_t)candidates[c];
+                return k;
+            }
+        }
+    }
+    return -1;
+}
+
+static size_t _fmt_special(char *out, double value)
+{
+    const char *s = isnan(value) ? "nan" : value < 0 ? "-inf" : "inf";
+    size_t n = strlen(s);
+    memcpy(out, s, n + 1);
+    return n;
+}
+
+/*
+* Round tripping is monotonic in the precision (more correctly rounded
+* digits only get closer), so binary search the shortest %.*g that parses
+* back; 17 digits always do for a double and 9 for a float.
+*/
+static size_t _shortest_printf(char *out, double value, bool single)
+{
+    int lo = 1, hi = single ? 9 : 17;
+    while (lo < hi)
+    {
+        int precision = lo + (hi - lo) / 2;
+        snprintf(out, SPDA_TEXT_MAX, "%.*g", precision, value);
+        bool exact = single ? strtof(out, NULL) == (float)value : strtod(out, NULL) == value;
+        if (exact) hi = precision;
+        else lo = precision + 1;
+    }
+    return (size_t)snprintf(out, SPDA_TEXT_MAX, "%.*g", lo, value);
+}
+
+size_t spda_format_double(char *out, double value)
+{
+    if (!isfinite(value)) return _fmt_special(out, value);
+
+    double x = fabs(value);
+    uint64_t m;
+    int k;
+    if (x == 0.0) return _fmt_fixed(out, signbit(value), 0, 0);
+    if (x >= 1e-4 && (k = _shortest_fixed(x, 53, &m)) >= 0) return _fmt_fixed(out, value < 0, m, k);
+
+    return _shortest_printf(out, value, false);
+}
+
+size_t spda_format_float(char *out, float value)
+{
+    if (!isfinite(value)) return _fmt_special(out, value);
+
+    float f = fabsf(value);
+    uint64_t m;
+    int k;
+    if (f == 0.0f) return _fmt_fixed(out, signbit(value), 0, 0);
+
+    if (f >= 1e-4f && (k = _shortest_fixed(f, 24, &m)) >= 0) return _fmt_fixed(out, value < 0, m, k);
+
+    return _shortest_printf(out, value, true);
+}
+
+/* ------------------------------------------------------------------------- */
+/*                                 WRITERS                                   */
+/* ------------------------------------------------------------------------- */
+
+static SpdaWriter *_writer_new(FILE *file, int fd)
+{
+    SpdaWriter *w = malloc(sizeof(SpdaWriter));
+    if (w == NULL) {
+        raise("MEM_ALLOCATION", "Failed to allocate writer");
+        return NULL;
+    }
+    w->buf = spda_reserve(char, SPDA_TEXT_BUFFER);
+    if (w->buf == NULL) {
+        free(w);
+        return NULL;
+    }
+    w->file = file;
+    w->fd = fd;
+    w->written = 0;
+    w->failed = false;
+    return w;
+}
+
+SpdaWriter *spda_writer_file(FILE *file)
+{
+    if (!file) {
+        raise("INVALID_SOURCE", "Output file cannot be NULL");
+        return NULL;
+    }
+    return _writer_new(file, -1);
+}
+
+SpdaWriter *spda_writer_fd(int fd)
+{
+    if (fd < 0) {
+        raise("INVALID_ARGUMENT", "Invalid output file descriptor");
+        return NULL;
+    }
+    return _writer_new(NULL, fd);
+}
+
+SpdaWriter *spda_writer_memory(void)
+{
+    return _writer_new(NULL, -1);
+}
+
+static inline bool _writer_is_memory(const SpdaWriter *w)
+{
+    return w->file == NULL && w->fd < 0;
+}
+
+bool spda_writer_flush(SpdaWriter *w)
+{
+    if (!w) return false;
+    if (_writer_is_memory(w)) return !w->failed;
+
+    size_t length = spda_char_len(w->buf);
+    if (w->file) {
+        if (fwrite(w->buf, 1, length, w->file) != length) w->failed = true;
+    } else {
+        for (size_t done = 0; done < length;)
+        {
+            ssize_t n = write(w->fd, w->buf + done, length - done);
+            if (n <= 0) {
+                w->failed = true;
+                break;
+            }
+            done += (size_t)n;
+        }
+    }
+    w->written += length;
+    spda_char_clear(w->buf);
+    return !w->failed;
+}
+
+/* At least `n` free bytes past the staged ones; returns where they start */
+static inline char *_writer_room(SpdaWriter *w, size_t n)
+{
+    size_t length = spda_char_len(w->buf);
+    if (spda_char_cap(w->buf) - length < n)
+    {
+        if (!_writer_is_memory(w)) {
+            spda_writer_flush(w);
+            length = 0;
+        }
+        if (spda_char_cap(w->buf) - length < n) {
+            w->buf = spda_char_grow(w->buf, n);
+            if (spda_char_cap(w->buf) - length < n) {
+                w->failed = true;
+                return NULL;
+            }
+        }
+    }
+    return w->buf + length;
+}
+
+static inline void _writer_commit(SpdaWriter *w, size_t n)
+{
+    spda_set_length(w->buf, spda_char_len(w->buf) + n);
+}
+
+bool spda_write_raw(SpdaWriter *w, const char *s, size_t n)
+{
+    char *dst = _writer_room(w, n);
+    if (dst == NULL) return false;
+    memcpy(dst, s, n);
+    _writer_commit(w, n);
+    return true;
+}
+
+char *spda_writer_release(SpdaWriter *w)
+{
+    if (!w || !_writer_is_memory(w)) {
+        raise("INVALID_ARGUMENT", "Only memory writers can release their buffer");
+        return NULL;
+    }
+    /* Without room for the terminator the output is not a string: give nothing back */
+    char *dst = _writer_room(w, 1);
+    char *buf = w->buf;
+    free(w);
+    if (dst == NULL) {
+        spda_char_destroy(buf);
+        return NULL;
+    }
+    *dst = '\0';
+    return buf;
+}
+
+bool spda_writer_destroy(SpdaWriter *w)
+{
+    if (!w) return false;
+    bool ok = spda_writer_flush(w);
+    spda_char_destroy(w->buf);
+    free(w);
+    return ok;
+}
+
+/* ------------------------------------------------------------------------- */
+/*                                  EXPORT                                   */
+/* ------------------------------------------------------------------------- */
+
+/* Formats element `i` straight into the staging buffer, followed by `sep` if non zero */
+static inline bool _write_value(SpdaWriter *w, const void *array, size_t i, SpdaTextType type, bool json, char sep)
+{
+    char *dst = _writer_room(w, SPDA_TEXT_MAX + 1);
+    if (dst == NULL) return false;
+
+    size_t n;
+    switch (type)
+    {
+        case SPDA_TEXT_I32: n = spda_format_int(dst, ((const int32_t *)array)[i]); break;
+        case SPDA_TEXT_I64: n = spda_format_int(dst, ((const int64_t *)array)[i]); break;
+        case SPDA_TEXT_F32: {
+            float v = ((const float *)array)[i];
+            if (json && !isfinite(v)) { memcpy(dst, "null", 4); n = 4; }
+            else n = spda_format_float(dst, v);
+            break;
+        }
+        default: {
+            double v = ((const double *)array)[i];
+            if (json && !isfinite(v)) { memcpy(dst, "null", 4); n = 4; }
+            else n = spda_format_double(dst, v);
+            break;
+        }
+    }
+    if (sep) dst[n++] = sep;
+    _writer_commit(w, n);
+    return true;
+}
+
+static bool _write_json_name(SpdaWriter *w, const char *name, size_t col)
+{
+    char fallback[24];
+    if (!name) {
+        snprintf(fallback, sizeof(fallback), "c%zu", col);
+        name = fallback;
+    }
+    bool ok = spda_write_raw(w, "\"", 1);
+    for (const char *p = name; *p && ok; ++p)
+    {
+        if (*p == '"' || *p == '\\') ok = spda_write_raw(w, "\\", 1);
+        ok = ok && spda_write_raw(w, p, 1);
+    }
+    return ok && spda_write_raw(w, "\":", 2);
+}
+
+/* CSV style: names holding the separator, a quote or a line break are quoted, inner quotes doubled */
+static bool _write_csv_name(SpdaWriter *w, const char *name, size_t col, char sep)
+{
+    char fallback[24];
+    if (!name) {
+        snprintf(fallback, sizeof(fallback), "c%zu", col);
+        name = fallback;
+    }
+    size_t n = strlen(name);
+    bool quote = memchr(name, sep, n) || strpbrk(name, "\"\r\n");
+    if (!quote) return spda_write_raw(w, name, n);
+
+    bool ok = spda_write_raw(w, "\"", 1);
+    for (const char *p = name; *p && ok; ++p)
+    {
+        if (*p == '"') ok = spda_write_raw(w, "\"", 1);
+        ok = ok && spda_write_raw(w, p, 1);
+    }
+    return ok && spda_write_raw(w, "\"", 1);
+}
+
+static bool _write_json_array(SpdaWriter *w, const void *array, SpdaTextType type)
+{
+    size_t length = spda_len(array);
+    bool ok = spda_write_raw(w, "[", 1);
+    for (size_t i = 0; ok && i < length; ++i) ok = _write_value(w, array, i, type, true, i + 1 < length ? ',' : 0);
+    return ok && spda_write_raw(w, "]", 1);
+}
+
+bool spda_write(SpdaWriter *w, const void *array, SpdaTextType type, SpdaTextFormat format)
+{
+    if (!w || !_text_check(array, type)) return false;
+
+    if (format == SPDA_TEXT_JSON) return _write_json_array(w, array, type) && spda_write_raw(w, "\n", 1);
+
+    size_t length = spda_len(array);
+    for (size_t i = 0; i < length; ++i)
+    {
+        if (!_write_value(w, array, i, type, false, '\n')) return false;
+    }
+    return !w->failed;
+}
+
+bool spda_write_table(SpdaWriter *w, const void *const *columns, const SpdaTextType *types,
+                      const char *const *names, size_t ncols, SpdaTextFormat format)
+{
+    if (!w || !columns || !types || ncols == 0) {
+        raise("INVALID_ARGUMENT", "Invalid writer or table");
+        return false;
+    }
+    size_t rows = 0;
+    for (size_t c = 0; c < ncols; ++c)
+    {
+        if (!_text_check(columns[c], types[c])) return false;
+        if (c > 0 && spda_len(columns[c]) != rows) {
+            raise("INVALID_ARGUMENT", "Table columns must have the same length");
+            return false;
+        }
+        rows = spda_len(columns[c]);
+    }
+
+    bool ok = true;
+    if (format == SPDA_TEXT_JSON) {
+        ok = spda_write_raw(w, "{", 1);
+        for (size_t c = 0; ok && c < ncols; ++c)
+        {
+            if (c > 0) ok = spda_write_raw(w, ",", 1);
+            ok = ok && _write_json_name(w, names ? names[c] : NULL, c) && _write_json_array(w, columns[c], types[c]);
+        }
+        return ok && spda_write_raw(w, "}\n", 2);
+    }
+
+    char sep = format == SPDA_TEXT_TSV ? '\t' : ',';
+    if (names) {
+        for (size_t c = 0; ok && c < ncols; ++c)
+        {
+            ok = _write_csv_name(w, names[c], c, sep);
+            ok = ok && spda_write_raw(w, c + 1 < ncols ? &sep : "\n", 1);
+        }
+    }
+    for (size_t r = 0; ok && r < rows; ++r)
+    {
+        for (size_t c = 0; ok && c < ncols; ++c) ok = _write_value(w, columns[c], r, types[c], false, c + 1 < ncols ? sep : '\n');
+    }
+    return ok && !w->failed;
+}
+
+/* ------------------------------------------------------------------------- */
+/*                                 PARSING                                   */
+/* ------------------------------------------------------------------------- */
+
+/* Separator bytes, plus '"' which opens a JSON key */
+enum { TEXT_SEP = 1, TEXT_QUOTE = 2 };
+static const unsigned char TEXT_CLASS[256] = {
+    ['\n'] = TEXT_SEP, ['\r'] = TEXT_SEP, ['\t'] = TEXT_SEP, [' '] = TEXT_SEP, [','] = TEXT_SEP,
+    ['['] = TEXT_SEP, [']'] = TEXT_SEP, ['{'] = TEXT_SEP, ['}'] = TEXT_SEP, [':'] = TEXT_SEP,
+    ['"'] = TEXT_QUOTE,
+};
+
+static inline bool _is_sep(char c)
+{
+    return TEXT_CLASS[(unsigned char)c] == TEXT_SEP;
+}
+
+/* Skips separators and quoted JSON keys; returns the start of the next token or `end` */
+static inline const char *_skip_sep(const char *p, const char *end)
+{
+    while (p < end)
+    {
+        if (*p == '"') {
+            for (++p; p < end && *p != '"'; ++p) {
+                if (*p == '\\' && p + 1 < end) ++p;
+            }
+            if (p < end) ++p;
+        } else if (_is_sep(*p)) {
+            ++p;
+        } else {
+            break;
+        }
+    }
+    return p;
+}
+
+static inline const char *_token_end(const char *p, const char *end)
+{
+    while (p < end && TEXT_CLASS[(unsigned char)*p] == 0) ++p;
+    return p;
+}
+
+static bool _parse_int(const char *p, const char *end, int64_t min, int64_t max, int64_t *out)
+{
+    if (p == end) return false;
+    bool negative = *p == '-';
+    if (*p == '-' || *p == '+') ++p;
+    if (p == end) return false;
+
+    uint64_t v = 0;
+    for (; p < end; ++p)
+    {
+        unsigned d = (unsigned)(*p - '0');
+        if (d > 9 || v > (UINT64_MAX - d) / 10) return false;
+        v = v * 10 + d;
+    }
+    if (v > (negative ? (uint64_t)0 - (uint64_t)min : (uint64_t)max)) return false;
+    *out = negative ? (int64_t)(0 - v) : (int64_t)v;
+    return true;
+}
+
+/* strtod on a private NUL terminated copy of the token, on the heap when it is long (%f of 1e300) */
+static bool _parse_slow(const char *p, const char *end, bool single, double *out)
+{
+    char local[64];
+    size_t n = (size_t)(end - p);
+    char *token = n < sizeof(local) ? local : malloc(n + 1);
+    if (token == NULL) {
+        raise("MEM_ALLOCATION", "Failed to allocate the token copy");
+        return false;
+    }
+    memcpy(token, p, n);
+    token[n] = '\0';
+
+    bool ok = true;
+    if (strcmp(token, "null") == 0) {
+        *out = NAN;
+    } else {
+        char *stop;
+        *out = single ? (double)strtof(token, &stop) : strtod(token, &stop);
+        ok = stop == token + n && n > 0;
+    }
+    if (token != local) free(token);
+    return ok;
+}
+
+/*
+* Decimal mantissa m and exponent e with m <= 2^53 and |e| <= 22 convert
+* exactly with one multiplication or division (Clinger's fast path).
+*/
+static bool _parse_real(const char *p, const char *end, bool single, double *out)
+{
+    const char *start = p;
+    bool negative = *p == '-';
+    if (*p == '-' || *p == '+') ++p;
+
+    uint64_t m = 0;
+    int digits = 0, exp10 = 0;
+    bool any = false, fast = true;
+    for (; p < end && (unsigned)(*p - '0') <= 9; ++p, any = true)
+    {
+        if (digits < 19) { m = m * 10 + (unsigned)(*p - '0'); digits += m > 0; }
+        else { fast = false; }
+    }
+    if (p < end && *p == '.') {
+        for (++p; p < end && (unsigned)(*p - '0') <= 9; ++p, any = true)
+        {
+            if (digits < 19) { m = m * 10 + (unsigned)(*p - '0'); digits += m > 0; --exp10; }
+            else { fast = false; }
+        }
+    }
+    if (any && p < end && (*p == 'e' || *p == 'E')) {
+        int64_t e;
+        if (!_parse_int(p + 1, end, -100000, 100000, &e)) return false;
+        exp10 += (int)e;
+        p = end;
+    }
+    if (!any || p != end) return _parse_slow(start, end, single, out);
+
+    if (fast && m <= (uint64_t)TWO_POW_53 && exp10 >= -22 && exp10 <= 22) {
+        double d = exp10 < 0 ? (double)m / POW10[-exp10] : (double)m * POW10[exp10];
+        if (!single) {
+            *out = negative ? -d : d;
+            return true;
+        }
+        /* Rounding d to float is only safe if d sits strictly inside the float's interval */
+        float f = (float)d;
+        double lo = ((double)f + (double)nextafterf(f, 0.0f)) / 2;
+        double hi = ((double)f + (double)nextafterf(f, INFINITY)) / 2;
+        if (d == (double)f || (lo < d && d < hi)) {
+            *out = negative ? -(double)f : (double)f;
+            return true;
+        }
+    }
+    return _parse_slow(start, end, single, out);
+}
+
+void *spda_parse(void *array, const char *text, size_t size, SpdaTextType type)
+{
+    if (!_text_check(array, type) || !text || size == 0) return array;
+
+    /* Count the tokens so the array grows at most once */
+    const char *end = text + size;
+    size_t tokens = 0;
+    for (const char *p = _skip_sep(text, end); p < end; p = _skip_sep(_token_end(p, end), end)) ++tokens;
+
+    size_t length = spda_len(array);
+    if (spda_cap(array) - length < tokens) {
+        void *new_array = _spda_resize(array, length + tokens);
+        if (new_array == NULL) {
+            raise("MEM_ALLOCATION", "Failed to reserve the parsed array");
+            return array;
+        }
+        array = new_array;
+    }
+
+    const char *p = text;
+    size_t n = length;
+    while (p < end)
+    {
+        p = _skip_sep(p, end);
+        if (p == end) break;
+        const char *token = p;
+        p = _token_end(p, end);
+
+        int64_t i;
+        double d;
+        bool ok;
+        switch (type)
+        {
+            case SPDA_TEXT_I32: ok = _parse_int(token, p, INT32_MIN, INT32_MAX, &i); if (ok) ((int32_t *)array)[n] = (int32_t)i; break;
+            case SPDA_TEXT_I64: ok = _parse_int(token, p, INT64_MIN, INT64_MAX, &i); if (ok) ((int64_t *)array)[n] = i; break;
+            case SPDA_TEXT_F32: ok = _parse_real(token, p, true, &d); if (ok) ((float *)array)[n] = (float)d; break;
+            default:            ok = _parse_real(token, p, false, &d); if (ok) ((double *)array)[n] = d; break;
+        }
+        if (!ok) {
+            raise("PARSE_ERROR", "Malformed or out of range number");
+            break;
+        }
+        ++n;
+    }
+    spda_set_length(array, n);
+    return array;
+}
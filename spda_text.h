@@ -0,0 +1,96 @@
+/*
+**  @brief: Buffered text export and bulk parsing for numeric spda arrays **
+*   @Author: Samarth Pyati
+*   @Date : 19-10-2026
+*   @Version : 1.0
+*/
+
+#ifndef SPDA_TEXT_H_
+#define SPDA_TEXT_H_
+
+#include <stdio.h>          // FILE
+#include <stddef.h>         // size_t
+#include <stdbool.h>        // bool
+#include "spda.h"
+
+/*
+** Text Export **
+* A SpdaWriter stages output in a SPDA_TEXT_BUFFER byte spda char array and
+* hands it to a FILE*, a file descriptor or keeps growing it in memory. Each
+* element costs a few stores instead of a printf call.
+*
+* Integers are formatted two digits at a time. Floats and doubles are
+* written with the fewest digits that parse back to the same value: from
+* 1e-4 up to about 2^54 the fixed notation form is found exactly with
+* 128-bit integer arithmetic on the value's rounding interval, and anything
+* else binary searches the shortest %.*g precision that round trips.
+*
+* Formats:
+*   SPDA_TEXT_CSV / SPDA_TEXT_TSV : one value per line for a single array;
+*                                   tables get an optional header row, names
+*                                   quoted CSV style when they need it.
+*   SPDA_TEXT_JSON                : [1,2,3] for a single array, and
+*                                   {"name":[...],...} for tables. Non-finite
+*                                   values are written as null.
+*
+** Parsing **
+* spda_parse appends every number in `text` to a spda array, reserving once
+* up front. Commas, tabs, whitespace, JSON brackets, braces, colons and
+* quoted keys all separate values, so everything written above parses back:
+* single arrays as they were, CSV/TSV tables row major (without the header
+* row, which is not accepted) and JSON tables column major, one column after
+* the other. Decimals that fit 2^53 with a power of ten up to 1e22 are
+* converted exactly without strtod.
+*
+* A malformed or out of range token stops the parse: PARSE_ERROR is
+* reported on stderr and the array keeps the values before it. Compare
+* spda_len before and after the call to tell a short parse from a full one.
+*/
+
+#define SPDA_TEXT_BUFFER (1 << 16)
+#define SPDA_TEXT_MAX 32          // longest formatted value, NUL included
+
+typedef enum {
+    SPDA_TEXT_I32,
+    SPDA_TEXT_I64,
+    SPDA_TEXT_F32,
+    SPDA_TEXT_F64,
+} SpdaTextType;
+
+typedef enum {
+    SPDA_TEXT_CSV,
+    SPDA_TEXT_TSV,
+    SPDA_TEXT_JSON,
+} SpdaTextFormat;
+
+typedef struct {
+    char *buf;              // spda char array: staged bytes, or the whole output in memory
+    FILE *file;             // stream sink, NULL otherwise
+    int fd;                 // descriptor sink, -1 otherwise
+    size_t written;         // bytes handed to the sink so far
+    bool failed;            // a write to the sink failed
+} SpdaWriter;
+
+/* Writers */
+SpdaWriter *spda_writer_file(FILE *file);
+SpdaWriter *spda_writer_fd(int fd);
+SpdaWriter *spda_writer_memory(void);
+bool spda_writer_flush(SpdaWriter *w);
+char *spda_writer_release(SpdaWriter *w);       // memory writer: frees `w`, returns the output (NUL terminated) or NULL
+bool spda_writer_destroy(SpdaWriter *w);        // flushes, then frees; false if any write failed
+
+/* Formatting single values into `out` (SPDA_TEXT_MAX bytes), returns the length */
+size_t spda_format_int(char *out, long long value);
+size_t spda_format_double(char *out, double value);
+size_t spda_format_float(char *out, float value);
+
+/* Export */
+bool spda_write_raw(SpdaWriter *w, const char *s, size_t n);
+bool spda_write(SpdaWriter *w, const void *array, SpdaTextType type, SpdaTextFormat format);
+bool spda_write_table(SpdaWriter *w, const void *const *columns, const SpdaTextType *types,
+                      const char *const *names, size_t ncols, SpdaTextFormat format);
+
+/* Parsing */
+void *spda_parse(void *array, const char *text, size_t size, SpdaTextType type);    // returns the (possibly moved) array
+
+#endif // SPDA_TEXT_H_
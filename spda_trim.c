@@ -0,0 +1,219 @@
+#define _DEFAULT_SOURCE             // madvise, MADV_FREE, clock_gettime under -std=c17
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include "spda_trim.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define SPDA_HAS_MADVISE 1
+#endif
+
+struct SpdaTrim {
+    void **slot;                // caller's variable holding the array
+    SpdaTrimPolicy policy;
+    size_t armed_ops;           // consecutive notifications spent under the threshold
+    double armed_since;         // when the shrink got armed (only with decay_seconds)
+    size_t released_len;        // length at the last madvise, SIZE_MAX if none
+};
+
+/* Process wide registry of attached arrays (itself an spda array of pointers) */
+static SpdaTrim **trim_registry = NULL;
+static SpdaTrimStats trim_stats = {0};
+
+static double _spda_trim_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+SpdaTrim *_spda_trim_attach(void **slot, const SpdaTrimPolicy *policy)
+{
+    if (!slot || !*slot) {
+        raise("INVALID_SOURCE", "Source array cannot be NULL");
+        return NULL;
+    }
+
+    if (trim_registry == NULL) {
+        trim_registry = spda_create(SpdaTrim *);
+        if (trim_registry == NULL) return NULL;
+    }
+
+    SpdaTrim *trim = malloc(sizeof(SpdaTrim));
+    if (trim == NULL) {
+        raise("MEM_ALLOCATION", "Failed to allocate trim policy");
+        return NULL;
+    }
+
+    trim->slot = slot;
+    trim->policy = policy ? *policy : SPDA_TRIM_DEFAULT_POLICY;
+    trim->armed_ops = 0;
+    trim->armed_since = 0.0;
+    trim->released_len = SIZE_MAX;
+    spda_append(trim_registry, trim);
+    return trim;
+}
+
+void spda_trim_detach(SpdaTrim *trim)
+{
+    if (!trim || !trim_registry) return;
+
+    size_t count = spda_len(trim_registry);
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (trim_registry[i] != trim) continue;
+        trim_registry[i] = trim_registry[count - 1];
+        spda_pop(trim_registry);
+        break;
+    }
+    free(trim);
+
+    if (spda_len(trim_registry) == 0) {
+        spda_destroy(trim_registry);
+        trim_registry = NULL;
+    }
+}
+
+/*
+* madvise is only safe on pages the allocator mapped for this block alone:
+* on heap (brk / arena) pages it would race the allocator's own use of the
+* neighbouring memory. glibc serves large blocks straight from mmap and
+* marks them with IS_MMAPPED (0x2) in the chunk size word just before the
+* block. Elsewhere, and under ASan whose allocator has no such word, no
+* block qualifies.
+*/
+static bool _spda_block_is_mmapped(const void *array)
+{
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__)
+    const size_t *block = (const size_t *)array - FIELD_COUNT;
+    return (block[-1] & 0x2) != 0;
+#else
+    (void)array;
+    return false;
+#endif
+}
+
+size_t spda_release_tail(void *array, bool lazy)
+{
+#ifdef SPDA_HAS_MADVISE
+    if (!array || !_spda_block_is_mmapped(array)) return 0;
+
+    /* Only whole pages strictly inside [length, capacity) may be dropped */
+    uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t begin = (uintptr_t)array + spda_len(array) * spda_stride(array);
+    uintptr_t end = (uintptr_t)array + spda_cap(array) * spda_stride(array);
+    begin = (begin + page - 1) & ~(page - 1);
+    end &= ~(page - 1);
+    if (end <= begin) return 0;
+
+    int rc = -1;
+#ifdef MADV_FREE
+    /* MADV_FREE only reclaims under memory pressure, but is cheaper to refault */
+    if (lazy) rc = madvise((void *)begin, end - begin, MADV_FREE);
+#endif
+    if (rc != 0) rc = madvise((void *)begin, end - begin, MADV_DONTNEED);
+    if (rc != 0) {
+        raise("MEM_ADVISE", "Failed to release the unused tail of the array");
+        return 0;
+    }
+    trim_stats.madvises++;
+    trim_stats.bytes_released += end - begin;
+    return end - begin;
+#else
+    (void)array;
+    (void)lazy;
+    return 0;
+#endif
+}
+
+/* Shrink to `new_cap` elements, returns the bytes given back */
+static size_t _spda_trim_resize(SpdaTrim *trim, size_t new_cap)
+{
+    void *array = *trim->slot;
+    size_t cap = spda_cap(array);
+    if (new_cap >= cap) return 0;
+
+    void *new_array = _spda_resize(array, new_cap);
+    if (new_array == NULL) return 0;
+
+    *trim->slot = new_array;
+    trim->released_len = SIZE_MAX;
+    size_t released = (cap - new_cap) * spda_stride(new_array);
+    trim_stats.shrinks++;
+    trim_stats.bytes_released += released;
+    return released;
+}
+
+static size_t _spda_trim_floor(const SpdaTrim *trim)
+{
+    return trim->policy.min_capacity > SPDA_DEFAULT_CAPACITY ? trim->policy.min_capacity : SPDA_DEFAULT_CAPACITY;
+}
+
+bool spda_trim_note(SpdaTrim *trim)
+{
+    if (!trim) return false;
+
+    void *array = *trim->slot;
+    const SpdaTrimPolicy *policy = &trim->policy;
+    size_t len = spda_len(array);
+    size_t cap = spda_cap(array);
+
+    /*
+    * Pages released earlier may have been touched again once the array regrew.
+    * Otherwise the tail only becomes worth releasing again after the length
+    * drops under the threshold relative to the previous release.
+    */
+    if (trim->released_len != SIZE_MAX && len > trim->released_len) trim->released_len = SIZE_MAX;
+    size_t reference = trim->released_len != SIZE_MAX ? trim->released_len : cap;
+
+    if (cap <= _spda_trim_floor(trim) || (double)len >= (double)reference * policy->shrink_below)
+    {
+        trim->armed_ops = 0;
+        return false;
+    }
+
+    if (trim->armed_ops++ == 0 && policy->decay_seconds > 0) trim->armed_since = _spda_trim_now();
+
+    bool expired = trim->armed_ops > policy->decay_ops;
+    if (!expired && policy->decay_seconds > 0)
+        expired = _spda_trim_now() - trim->armed_since >= policy->decay_seconds;
+    if (!expired) return false;
+
+    trim->armed_ops = 0;
+
+    /* Blocks that are not madvise-able fall back to the realloc shrink */
+    size_t tail_bytes = (cap - len) * spda_stride(array);
+    if (policy->madvise_bytes > 0 && tail_bytes >= policy->madvise_bytes
+        && spda_release_tail(array, policy->madvise_lazy) > 0) {
+        trim->released_len = len;
+        return true;
+    }
+
+    size_t new_cap = (size_t)((double)len / policy->shrink_to);
+    if (new_cap < _spda_trim_floor(trim)) new_cap = _spda_trim_floor(trim);
+    return _spda_trim_resize(trim, new_cap) > 0;
+}
+
+size_t spda_trim_all(void)
+{
+    if (trim_registry == NULL) return 0;
+
+    size_t released = 0;
+    for (size_t i = 0; i < spda_len(trim_registry); ++i)
+    {
+        SpdaTrim *trim = trim_registry[i];
+        size_t new_cap = spda_len(*trim->slot);
+        if (new_cap < _spda_trim_floor(trim)) new_cap = _spda_trim_floor(trim);
+        released += _spda_trim_resize(trim, new_cap);
+        trim->armed_ops = 0;
+    }
+    return released;
+}
+
+SpdaTrimStats spda_trim_stats(void)
+{
+    return trim_stats;
+}
@@ -0,0 +1,95 @@
+/*
+**  @brief: Opt-in automatic shrinking / memory return policy for spda arrays **
+*   @Author: Samarth Pyati
+*   @Date : 19-10-2026
+*   @Version : 1.0
+*/
+
+#ifndef SPDA_TRIM_H_
+#define SPDA_TRIM_H_
+
+#include <stddef.h>         // size_t
+#include <stdbool.h>        // bool
+#include "spda.h"
+
+/*
+** Trim Policy **
+* Arrays grow when utilisation hits 100% and land at 50%. Shrinking only arms
+* once utilisation drops below `shrink_below` and then lands at `shrink_to`,
+* so a workload oscillating around a capacity boundary never reallocs back
+* and forth. On top of that an armed array must stay armed for `decay_ops`
+* notifications or `decay_seconds` before it is actually shrunk.
+*
+* Tails of at least `madvise_bytes` are handed back to the kernel with
+* madvise(MADV_DONTNEED, or MADV_FREE with `madvise_lazy`) instead of being
+* realloc'd, which keeps the array pointer (and capacity) stable. Set it to 0
+* to always realloc. Only blocks the allocator mapped on their own (large
+* arrays under glibc malloc) qualify; spda_release_tail returns 0 for any
+* other block and the policy reallocs instead.
+*/
+typedef struct {
+    double shrink_below;        // utilisation that arms the shrink
+    double shrink_to;           // utilisation right after shrinking
+    size_t min_capacity;        // never shrink below this many elements
+    size_t decay_ops;           // armed notifications before shrinking (0 = immediately)
+    double decay_seconds;       // or armed duration before shrinking (0 = disabled)
+    size_t madvise_bytes;       // release tails this large with madvise (0 = never)
+    bool madvise_lazy;          // MADV_FREE (reclaimed under pressure) instead of MADV_DONTNEED
+} SpdaTrimPolicy;
+
+#define SPDA_TRIM_DEFAULT_POLICY                                \
+    ((SpdaTrimPolicy) {                                         \
+        .shrink_below = SPDA_SHRINK_THRESHOLD,                  \
+        .shrink_to = 0.5,                                       \
+        .min_capacity = SPDA_DEFAULT_CAPACITY,                  \
+        .decay_ops = 64,                                        \
+        .decay_seconds = 0.0,                                   \
+        .madvise_bytes = 0,                                     \
+        .madvise_lazy = false,                                  \
+    })
+
+typedef struct SpdaTrim SpdaTrim;
+
+typedef struct {
+    size_t shrinks;             // realloc based shrinks
+    size_t madvises;            // tails released with madvise
+    size_t bytes_released;      // total bytes returned by both
+} SpdaTrimStats;
+
+/* Attach / Detach */
+SpdaTrim *_spda_trim_attach(void **slot, const SpdaTrimPolicy *policy);    // NULL policy = default
+void spda_trim_detach(SpdaTrim *trim);
+
+/* Policy Operations */
+bool spda_trim_note(SpdaTrim *trim);                // call after pop/remove/clear, true if memory was returned
+size_t spda_trim_all(void);                         // shrink every attached array to fit, returns bytes released
+size_t spda_release_tail(void *array, bool lazy);   // madvise the unused capacity, returns bytes released
+SpdaTrimStats spda_trim_stats(void);
+
+/*
+* `array` is the caller's variable holding the spda array: the policy layer
+* keeps its address and rewrites it whenever a shrink moves the array.
+* Not thread safe, attach, note and trim from the thread owning the arrays.
+*/
+#define spda_trim_attach(array, policy) \
+    _spda_trim_attach((void **)&(array), (policy))
+
+#define spda_pop_trim(array, trim)      \
+    do {                                \
+        _spda_pop(array);               \
+        spda_trim_note(trim);           \
+    } while (0)
+
+#define spda_remove_trim(array, idx, trim)  \
+    do {                                    \
+        _spda_remove((array), (idx));       \
+        spda_trim_note(trim);               \
+    } while (0)
+
+#define spda_clear_trim(array, trim)    \
+    do {                                \
+        spda_clear(array);              \
+        spda_trim_note(trim);           \
+    } while (0)
+
+#endif // SPDA_TRIM_H_
@@ -0,0 +1,332 @@
+/*
+**  @brief: Typed, compile-time specialized front end for spda arrays **
+*   @Author: Samarth Pyati
+*   @Date : 19-10-2026
+*   @Version : 1.0
+*/
+
+#ifndef SPDA_TYPED_H_
+#define SPDA_TYPED_H_
+
+#include <stddef.h>         // size_t
+#include <string.h>         // memmove, memcpy
+#include "spda.h"
+
+/*
+** Typed Arrays **
+* SPDA_DEFINE(name, T) stamps out `static inline` functions operating on `T *`
+* directly. They use the exact same header layout as the void* API, so arrays
+* can be passed freely between typed and untyped code:
+*
+*   SPDA_DEFINE(points, Point3D)
+*   Point3D *ps = points_create();
+*   ps = points_append(ps, p);
+*   spda_print(ps, printPoint3D);       // untyped API still works
+*
+* Only the cold growth path calls into spda.c, everything else is inlined and
+* specialized on sizeof(T) by the compiler.
+*
+* SPDA_DEFINE_SORT(name, T, less) additionally generates `name_sort`,
+* `name_lower_bound` and `name_bsearch` using `less(a, b)` which may be a
+* function-like macro (see SPDA_LT) or a function.
+*/
+
+#define SPDA_HEADER(array) ((size_t *)(array) - FIELD_COUNT)
+#define SPDA_LT(a, b) ((a) < (b))
+
+/* Debug builds verify the header and poison vacated slots, like the void* API */
+#ifdef SPDA_DEBUG
+#define SPDA_TYPED_CHECK(array) _spda_debug_check((array), __FILE__, __LINE__)
+#define SPDA_TYPED_VACATE(array, from, count) _spda_debug_vacate((array), (from), (count))
+#else
+#define SPDA_TYPED_CHECK(array) ((void)0)
+#define SPDA_TYPED_VACATE(array, from, count) ((void)0)
+#endif
+
+/* Below this many elements the sort falls back to insertion sort */
+#define SPDA_SORT_INSERTION_THRESHOLD 16
+
+#define SPDA_DEFINE(name, T)                                                            \
+    static inline T *name##_reserve(size_t capacity)                                    \
+    {                                                                                   \
+        return (T *) _spda_create(capacity, sizeof(T));                                 \
+    }                                                                                   \
+                                                                                        \
+    static inline T *name##_create(void)                                                \
+    {                                                                                   \
+        return name##_reserve(SPDA_DEFAULT_CAPACITY);                                   \
+    }                                                                                   \
+                                                                                        \
+    static inline size_t name##_len(const T *array)                                     \
+    {                                                                                   \
+        SPDA_TYPED_CHECK(array);                                                        \
+        return SPDA_HEADER(array)[LENGTH];                                              \
+    }                                                                                   \
+                                                                                        \
+    static inline size_t name##_cap(const T *array)                                     \
+    {                                                                                   \
+        SPDA_TYPED_CHECK(array);                                                        \
+        return SPDA_HEADER(array)[CAPACITY];                                            \
+    }                                                                                   \
+                                                                                        \
+    static inline T name##_get(const T *array, size_t idx)                              \
+    {                                                                                   \
+        return spda_at(array, idx);                                                     \
+    }                                                                                   \
+                                                                                        \
+    static inline void name##_set(T *array, size_t idx, T value)                        \
+    {                                                                                   \
+        spda_at(array, idx) = value;                                                    \
+    }                                                                                   \
+                                                                                        \
+    /* Make room for `extra` more elements, returns the (possibly moved) array */       \
+    static inline T *name##_grow(T *array, size_t extra)                                \
+    {                                                                                   \
+        SPDA_TYPED_CHECK(array);                                                        \
+        size_t *header = SPDA_HEADER(array);                                            \
+        size_t need = header[LENGTH] + extra;                                           \
+        if (need <= header[CAPACITY]) return array;                                     \
+        size_t new_cap = header[CAPACITY] * SPDA_GROWTH_FACTOR;                         \
+        if (new_cap < need) new_cap = need;                                             \
+        T *new_array = (T *) _spda_resize(array, new_cap);                              \
+        if (new_array == NULL) {                                                        \
+            raise("MEM_ALLOCATION", "Failed to resize array");                          \
+            return array;                                                               \
+        }                                                                               \
+        return new_array;                                                               \
+    }                                                                                   \
+                                                                                        \
+    static inline T *name##_append(T *array, T value)                                   \
+    {                                                                                   \
+        SPDA_TYPED_CHECK(array);                                                        \
+        size_t *header = SPDA_HEADER(array);                                            \
+        if (header[LENGTH] >= header[CAPACITY]) {                                       \
+            array = name##_grow(array, 1);                                              \
+            header = SPDA_HEADER(array);                                                \
+            if (header[LENGTH] >= header[CAPACITY]) return array;                       \
+        }                                                                               \
+        array[header[LENGTH]++] = value;                                                \
+        return array;                                                                   \
+    }                                                                                   \
+                                                                                        \
+    static inline T *name##_append_many(T *array, const T *items, size_t count)         \
+    {                                                                                   \
+        array = name##_grow(array, count);                                              \
+        size_t *header = SPDA_HEADER(array);                                            \
+        if (header[CAPACITY] - header[LENGTH] < count) return array;                    \
+        memcpy(array + header[LENGTH], items, count * sizeof(T));                       \
+        header[LENGTH] += count;                                                        \
+        return array;                                                                   \
+    }                                                                                   \
+                                                                                        \
+    static inline T *name##_insert(T *array, size_t idx, T value)                       \
+    {                                                                                   \
+        size_t length = name##_len(array);                                              \
+        if (idx > length) {                                                             \
+            raise("INDEX_OUT_OF_BOUNDS", "Index out of bounds for insert");             \
+            return array;                                                               \
+        }                                                                               \
+        array = name##_grow(array, 1);                                                  \
+        if (name##_cap(array) <= length) return array;                                  \
+        memmove(array + idx + 1, array + idx, (length - idx) * sizeof(T));              \
+        array[idx] = value;                                                             \
+        SPDA_HEADER(array)[LENGTH] = length + 1;                                        \
+        return array;                                                                   \
+    }                                                                                   \
+                                                                                        \
+    static inline T *name##_remove(T *array, size_t idx)                                \
+    {                                                                                   \
+        size_t length = name##_len(array);                                              \
+        if (idx >= length) {                                                            \
+            raise("INDEX_OUT_OF_BOUNDS", "Index out of bounds for remove");             \
+            return array;                                                               \
+        }                                                                               \
+        memmove(array + idx, array + idx + 1, (length - idx - 1) * sizeof(T));          \
+        SPDA_HEADER(array)[LENGTH] = length - 1;                                        \
+        SPDA_TYPED_VACATE(array, length - 1, 1);                                        \
+        return array;                                                                   \
+    }                                                                                   \
+                                                                                        \
+    /* Pops the last element into `dest` (may be NULL), false if empty */               \
+    static inline bool name##_pop(T *array, T *dest)                                    \
+    {                                                                                   \
+        SPDA_TYPED_CHECK(array);                                                        \
+        size_t *header = SPDA_HEADER(array);                                            \
+        if (header[LENGTH] == 0) {                                                      \
+            raise("INDEX_OUT_OF_BOUNDS", "Cannot pop elements from an empty array");    \
+            return false;                                                               \
+        }                                                                               \
+        header[LENGTH]--;                                                               \
+        if (dest) *dest = array[header[LENGTH]];                                        \
+        SPDA_TYPED_VACATE(array, header[LENGTH], 1);                                    \
+        return true;                                                                    \
+    }                                                                                   \
+                                                                                        \
+    static inline void name##_clear(T *array)                                           \
+    {                                                                                   \
+        SPDA_TYPED_CHECK(array);                                                        \
+        SPDA_HEADER(array)[LENGTH] = 0;                                                 \
+    }                                                                                   \
+                                                                                        \
+    static inline void name##_reverse(T *array)                                         \
+    {                                                                                   \
+        size_t length = name##_len(array);                                              \
+        for (size_t i = 0; i < length / 2; ++i) {                                       \
+            T temp = array[i];                                                          \
+            array[i] = array[length - i - 1];                                           \
+            array[length - i - 1] = temp;                                               \
+        }                                                                               \
+    }                                                                                   \
+                                                                                        \
+    static inline void name##_destroy(T *array)                                         \
+    {                                                                                   \
+        _spda_destroy(array);                                                           \
+    }
+
+/*
+* Introsort: median-of-three quicksort looping on the larger half, insertion
+* sort for short ranges and heapsort once the recursion depth budget runs out.
+*/
+#define SPDA_DEFINE_SORT(name, T, less)                                                 \
+    static inline void name##_insertion_sort_(T *a, size_t n)                           \
+    {                                                                                   \
+        for (size_t i = 1; i < n; ++i) {                                                \
+            T key = a[i];                                                               \
+            size_t j = i;                                                               \
+            while (j > 0 && less(key, a[j - 1])) { a[j] = a[j - 1]; --j; }              \
+            a[j] = key;                                                                 \
+        }                                                                               \
+    }                                                                                   \
+                                                                                        \
+    static inline void name##_sift_down_(T *a, size_t root, size_t n)                   \
+    {                                                                                   \
+        T value = a[root];                                                              \
+        size_t child;                                                                   \
+        while ((child = 2 * root + 1) < n) {                                            \
+            if (child + 1 < n && less(a[child], a[child + 1])) child++;                 \
+            if (!less(value, a[child])) break;                                          \
+            a[root] = a[child];                                                         \
+            root = child;                                                               \
+        }                                                                               \
+        a[root] = value;                                                                \
+    }                                                                                   \
+                                                                                        \
+    static inline void name##_heap_sort_(T *a, size_t n)                                \
+    {                                                                                   \
+        for (size_t i = n / 2; i-- > 0;) name##_sift_down_(a, i, n);                    \
+        for (size_t i = n; i-- > 1;) {                                                  \
+            T temp = a[0]; a[0] = a[i]; a[i] = temp;                                    \
+            name##_sift_down_(a, 0, i);                                                 \
+        }                                                                               \
+    }                                                                                   \
+                                                                                        \
+    static inline void name##_intro_sort_(T *a, size_t n, int depth)                    \
+    {                                                                                   \
+        while (n > SPDA_SORT_INSERTION_THRESHOLD) {                                     \
+            if (depth-- == 0) { name##_heap_sort_(a, n); return; }                      \
+            size_t mid = n / 2;                                                         \
+            T temp;                                                                     \
+            if (less(a[mid], a[0]))     { temp = a[mid]; a[mid] = a[0]; a[0] = temp; }  \
+            if (less(a[n - 1], a[mid])) {                                               \
+                temp = a[mid]; a[mid] = a[n - 1]; a[n - 1] = temp;                      \
+                if (less(a[mid], a[0])) { temp = a[mid]; a[mid] = a[0]; a[0] = temp; }  \
+            }                                                                           \
+            T pivot = a[mid];                                                           \
+            size_t i = 0, j = n - 1;                                                    \
+            for (;;) {                                                                  \
+                while (less(a[i], pivot)) ++i;                                          \
+                while (less(pivot, a[j])) --j;                                          \
+                if (i >= j) break;                                                      \
+                temp = a[i]; a[i] = a[j]; a[j] = temp;                                  \
+                ++i; --j;                                                               \
+            }                                                                           \
+            /* [0, j] <= pivot <= [j + 1, n) */                                         \
+            size_t left = j + 1, right = n - left;                                      \
+            if (left < right) {                                                         \
+                name##_intro_sort_(a, left, depth);                                     \
+                a += left; n = right;                                                   \
+            } else {                                                                    \
+                name##_intro_sort_(a + left, right, depth);                             \
+                n = left;                                                               \
+            }                                                                           \
+        }                                                                               \
+        name##_insertion_sort_(a, n);                                                   \
+    }                                                                                   \
+                                                                                        \
+    static inline void name##_sort(T *array)                                            \
+    {                                                                                   \
+        size_t n = name##_len(array);                                                   \
+        int depth = 0;                                                                  \
+        for (size_t m = n; m > 1; m >>= 1) depth += 2;                                  \
+        name##_intro_sort_(array, n, depth);                                            \
+    }                                                                                   \
+                                                                                        \
+    /* Index of the first element not less than `key` in a sorted array */              \
+    static inline size_t name##_lower_bound(const T *array, T key)                      \
+    {                                                                                   \
+        size_t lo = 0, hi = name##_len(array);                                          \
+        while (lo < hi) {                                                               \
+            size_t mid = lo + (hi - lo) / 2;                                            \
+            if (less(array[mid], key)) lo = mid + 1;                                    \
+            else hi = mid;                                                              \
+        }                                                                               \
+        return lo;                                                                      \
+    }                                                                                   \
+                                                                                        \
+    static inline T *name##_bsearch(T *array, T key)                                    \
+    {                                                                                   \
+        size_t idx = name##_lower_bound(array, key);                                    \
+        if (idx < name##_len(array) && !less(key, array[idx])) return array + idx;      \
+        return NULL;                                                                    \
+    }
+
+/* Typed API plus ordering by the builtin `<` operator */
+#define SPDA_DEFINE_ARITH(name, T)          \
+    SPDA_DEFINE(name, T)                    \
+    SPDA_DEFINE_SORT(name, T, SPDA_LT)
+
+/* Builtin instantiations */
+SPDA_DEFINE_ARITH(spda_char, char)
+SPDA_DEFINE_ARITH(spda_int, int)
+SPDA_DEFINE_ARITH(spda_uint, unsigned int)
+SPDA_DEFINE_ARITH(spda_long, long)
+SPDA_DEFINE_ARITH(spda_llong, long long)
+SPDA_DEFINE_ARITH(spda_float, float)
+SPDA_DEFINE_ARITH(spda_double, double)
+
+/*
+** C11 _Generic front end **
+* Dispatches on the pointer type of `array` to the builtin instantiations, e.g.
+*   int *a = spda_create(int);
+*   spda_t_append(a, 42);
+*   spda_t_sort(a);
+* Mutating operations reassign `array` just like the untyped macros.
+*/
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+
+#define _spda_t_dispatch(array, op)             \
+    _Generic((array),                           \
+        char *: spda_char_##op,                 \
+        int *: spda_int_##op,                   \
+        unsigned int *: spda_uint_##op,         \
+        long *: spda_long_##op,                 \
+        long long *: spda_llong_##op,           \
+        float *: spda_float_##op,               \
+        double *: spda_double_##op)
+
+#define spda_t_len(array)                   _spda_t_dispatch(array, len)(array)
+#define spda_t_get(array, idx)              _spda_t_dispatch(array, get)((array), (idx))
+#define spda_t_set(array, idx, value)       _spda_t_dispatch(array, set)((array), (idx), (value))
+#define spda_t_append(array, value)         ((array) = _spda_t_dispatch(array, append)((array), (value)))
+#define spda_t_append_many(array, items, count) \
+    ((array) = _spda_t_dispatch(array, append_many)((array), (items), (count)))
+#define spda_t_insert(array, idx, value)    ((array) = _spda_t_dispatch(array, insert)((array), (idx), (value)))
+#define spda_t_remove(array, idx)           ((array) = _spda_t_dispatch(array, remove)((array), (idx)))
+#define spda_t_pop(array, dest)             _spda_t_dispatch(array, pop)((array), (dest))
+#define spda_t_reverse(array)               _spda_t_dispatch(array, reverse)(array)
+#define spda_t_sort(array)                  _spda_t_dispatch(array, sort)(array)
+#define spda_t_bsearch(array, key)          _spda_t_dispatch(array, bsearch)((array), (key))
+
+#endif // __STDC_VERSION__ >= 201112L
+
+#endif // SPDA_TYPED_H_
@@ -1,7 +1,22 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 #include <math.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
 #include "../spda.h"
+#include "../spda_edit.h"
+#include "../spda_typed.h"
+#include "../spda_trim.h"
+#include "../spda_pack.h"
+#include "../spda_random.h"
+#include "../spda_set.h"
+#include "../spda_str.h"
+#include "../spda_shm.h"
+#include "../spda_text.h"
 
 #define RED         "\x1B[31m"
 #define GREEN       "\x1B[32m"
@@ -230,6 +245,761 @@ void test_foreach() {
     spda_destroy(array);
 }
 
+void test_gap_buffer() {
+    printf("\nTesting gap buffer...\n");
+    int *array = spda_create(int);
+    spda_append_many(array, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9);
+    SpdaGap *gb = spda_gap_from(array);
+
+    // Clustered edits in the middle, enough to force the buffer to grow
+    for (int i = 0; i < 100; i++) {
+        int v = 100 + i;
+        spda_gap_insert(gb, 5 + i, &v);
+    }
+    spda_gap_remove(gb, 0, 2);
+    TEST_ASSERT(spda_gap_len(gb) == 108,
+                "Gap buffer length is correct after edits",
+                "Gap buffer length did not match expected value");
+    TEST_ASSERT(*(int *)spda_gap_at(gb, 3) == 100 && *(int *)spda_gap_at(gb, 103) == 5,
+                "Gap buffer indexing skips the gap",
+                "Gap buffer indexing returned the wrong element");
+
+    array = spda_gap_release(gb);
+    bool success = spda_len(array) == 108 && array[0] == 2 && array[2] == 4 && array[102] == 199 && array[107] == 9;
+    TEST_ASSERT(success,
+                "Released gap buffer is a contiguous spda array",
+                "Released gap buffer contents are not contiguous");
+    spda_destroy(array);
+}
+
+void test_rope() {
+    printf("\nTesting chunked rope...\n");
+    int *expected = spda_create(int);
+    SpdaRope *rope = spda_rope_create(int);
+
+    // Enough inserts to split chunks several times
+    unsigned state = 1;
+    for (int i = 0; i < 5000; i++) {
+        state = state * 1103515245 + 12345;
+        int idx = (int)(state % (spda_len(expected) + 1));
+        spda_insert(expected, idx, i);
+        spda_rope_insert(rope, idx, &i);
+    }
+    for (int i = 0; i < 4000; i++) {
+        state = state * 1103515245 + 12345;
+        int idx = (int)(state % spda_len(expected));
+        spda_remove(expected, idx);
+        spda_rope_remove(rope, idx);
+    }
+
+    TEST_ASSERT(spda_rope_len(rope) == spda_len(expected),
+                "Rope length is correct after edits",
+                "Rope length did not match expected value");
+
+    int *flat = spda_rope_flatten(rope);
+    bool success = spda_len(flat) == spda_len(expected);
+    for (size_t i = 0; success && i < spda_len(flat); i++) {
+        if (flat[i] != expected[i] || *(int *)spda_rope_at(rope, i) != expected[i]) success = false;
+    }
+    TEST_ASSERT(success,
+                "Rope contents match plain spda array",
+                "Rope contents diverged from plain spda array");
+
+    spda_destroy(flat);
+    spda_destroy(expected);
+    spda_rope_destroy(rope);
+}
+
+void test_typed() {
+    printf("\nTesting typed API...\n");
+    int *array = spda_int_create();
+    for (int i = 0; i < 1000; i++) {
+        array = spda_int_append(array, (i * 7919) % 1000);
+    }
+    array = spda_int_insert(array, 0, -1);
+    array = spda_int_remove(array, 1);
+    TEST_ASSERT(spda_len(array) == 1000 && array[0] == -1,
+                "Typed arrays share the untyped header layout",
+                "Typed array header did not match the untyped API");
+
+    spda_int_sort(array);
+    bool success = true;
+    for (size_t i = 1; i < spda_int_len(array); i++) {
+        if (array[i - 1] > array[i]) success = false;
+    }
+    TEST_ASSERT(success,
+                "Typed sort orders the array",
+                "Typed sort left the array unsorted");
+    TEST_ASSERT(spda_int_bsearch(array, 500) != NULL && spda_int_bsearch(array, 5000) == NULL,
+                "Typed binary search finds present keys only",
+                "Typed binary search returned the wrong result");
+
+    // _Generic front end dispatches on the element type
+    double *doubles = spda_create(double);
+    spda_append_many(doubles, 3.5, 1.5, 2.5);
+    spda_t_append(doubles, 0.5);
+    spda_t_sort(doubles);
+    double last = 0.0;
+    bool popped = spda_t_pop(doubles, &last);
+    TEST_ASSERT(popped && double_equals(doubles[0], 0.5) && double_equals(last, 3.5) && spda_t_len(doubles) == 3,
+                "_Generic front end dispatches to the double instantiation",
+                "_Generic front end produced unexpected results");
+
+    spda_destroy(doubles);
+    spda_destroy(array);
+}
+
+void test_trim_policy() {
+    printf("\nTesting trim policy...\n");
+    int *array = spda_create(int);
+    SpdaTrimPolicy policy = SPDA_TRIM_DEFAULT_POLICY;
+    policy.decay_ops = 16;
+    SpdaTrim *trim = spda_trim_attach(array, &policy);
+
+    for (int i = 0; i <= 1024; i++) spda_append(array, i);
+    size_t peak_cap = spda_cap(array);
+    spda_pop(array);
+
+    // Bouncing across the growth boundary must not shrink anything
+    for (int round = 0; round < 100; round++) {
+        spda_append(array, round);
+        spda_pop_trim(array, trim);
+    }
+    TEST_ASSERT(spda_cap(array) == peak_cap,
+                "Oscillating around a boundary does not shrink",
+                "Array was shrunk while oscillating around a boundary");
+
+    // Dropping well below the threshold shrinks once the decay has passed
+    while (spda_len(array) > 100) spda_pop_trim(array, trim);
+    for (int i = 0; i < 32; i++) spda_trim_note(trim);
+    bool success = spda_cap(array) < peak_cap && spda_cap(array) >= 100 && array[99] == 99;
+    TEST_ASSERT(success,
+                "Array shrinks after staying under the threshold",
+                "Array did not shrink after staying under the threshold");
+
+    // Process wide trim shrinks to fit regardless of thresholds
+    while (spda_len(array) > 60) spda_pop(array);
+    spda_trim_all();
+    TEST_ASSERT(spda_cap(array) == 60 && array[59] == 59,
+                "spda_trim_all shrinks attached arrays to fit",
+                "spda_trim_all did not shrink the attached array");
+
+    spda_trim_detach(trim);
+    spda_destroy(array);
+
+    // madvise only touches whole pages of blocks the allocator mapped on their own
+    int *small = spda_reserve(int, 1024);
+    spda_append(small, 7);
+    success = spda_release_tail(small, false) == 0 && small[0] == 7;
+
+    char *big = spda_reserve(char, (size_t)64 << 20);
+    memset(big, 'x', (size_t)1 << 20);
+    spda_set_length(big, (size_t)1 << 20);
+    size_t released = spda_release_tail(big, false);
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__)
+    success = success && released > 0 && released % 4096 == 0 && released <= spda_cap(big) - spda_len(big);
+#else
+    success = success && released == 0;
+#endif
+    success = success && big[0] == 'x' && big[spda_len(big) - 1] == 'x';
+    big[spda_cap(big) - 1] = 'y';           // released pages come back zeroed on the next touch
+    success = success && big[spda_cap(big) - 1] == 'y';
+    TEST_ASSERT(success,
+                "Tails are released only from mmap'd blocks and keep the live elements",
+                "spda_release_tail touched a heap block or lost elements");
+
+    spda_destroy(big);
+    spda_destroy(small);
+}
+
+void test_pack() {
+    printf("\nTesting columnar compression...\n");
+    int *ints = spda_create(int);
+    long long *longs = spda_create(long long);
+    double *doubles = spda_create(double);
+    for (int i = 0; i < 1000; i++) {
+        spda_append(ints, i * 3 - (i % 7 == 0 ? 1000000 : 0));
+        spda_append(longs, (long long)i * 1000000007LL);
+        spda_append(doubles, 20.0 + (i % 10) * 0.25);
+    }
+
+    SpdaPacked *p_for = spda_pack_i32(ints, SPDA_PACK_DELTA_FOR);
+    SpdaPacked *p_var = spda_pack_i64(longs, SPDA_PACK_VARINT);
+    SpdaPacked *p_xor = spda_pack_f64(doubles);
+
+    int *u_ints = spda_unpack(p_for);
+    long long *u_longs = spda_unpack(p_var);
+    double *u_doubles = spda_unpack(p_xor);
+    bool success = spda_len(u_ints) == 1000 && spda_len(u_longs) == 1000 && spda_len(u_doubles) == 1000;
+    for (size_t i = 0; success && i < 1000; i++) {
+        success = u_ints[i] == ints[i] && u_longs[i] == longs[i] && u_doubles[i] == doubles[i];
+    }
+    TEST_ASSERT(success,
+                "DELTA_FOR, VARINT and XOR round trip exactly",
+                "Decoded arrays did not match the originals");
+    TEST_ASSERT(spda_packed_bytes(p_xor) < 1000 * sizeof(double),
+                "XOR codec compresses slowly varying doubles",
+                "XOR codec did not compress slowly varying doubles");
+
+    // Every bit width goes through its own unpack kernel
+    long long *widths = spda_create(long long);
+    long long value = 0;
+    for (unsigned w = 0; w <= 40; w++) {
+        for (int i = 0; i < SPDA_PACK_BLOCK; i++) {
+            value += (long long)(((unsigned long long)i * 2654435761u) & ((1ULL << w) - 1)) - 3;
+            spda_append(widths, value);
+        }
+    }
+    SpdaPacked *p_widths = spda_pack_i64(widths, SPDA_PACK_DELTA_FOR);
+    long long *u_widths = spda_unpack(p_widths);
+    success = spda_len(u_widths) == spda_len(widths)
+           && memcmp(u_widths, widths, spda_len(widths) * sizeof(long long)) == 0;
+    TEST_ASSERT(success,
+                "DELTA_FOR decodes every bit width",
+                "DELTA_FOR decode failed for some bit width");
+    spda_packed_destroy(p_widths);
+    spda_destroy(u_widths);
+    spda_destroy(widths);
+
+    // Random access into the middle without decoding everything: [100, 300) spans blocks 0 to 2
+    int window[200];
+    spda_unpack_range(p_for, 100, 200, window);
+    TEST_ASSERT(memcmp(window, ints + 100, sizeof(window)) == 0,
+                "Range decode across a block boundary is correct",
+                "Range decode returned the wrong elements");
+
+    spda_packed_destroy(p_for);
+    spda_packed_destroy(p_var);
+    spda_packed_destroy(p_xor);
+    spda_destroy(u_ints);
+    spda_destroy(u_longs);
+    spda_destroy(u_doubles);
+    spda_destroy(ints);
+    spda_destroy(longs);
+    spda_destroy(doubles);
+}
+
+void test_random() {
+    printf("\nTesting random generation...\n");
+    int *a = spda_rand_int(10000, 1234, -5, 5);
+    int *b = spda_rand_int(10000, 1234, -5, 5);
+    bool in_range = true;
+    for (size_t i = 0; i < spda_len(a); i++) {
+        if (a[i] < -5 || a[i] > 5) in_range = false;
+    }
+    TEST_ASSERT(in_range && memcmp(a, b, 10000 * sizeof(int)) == 0,
+                "Seeded generation is in range and reproducible",
+                "Seeded generation is out of range or not reproducible");
+
+    // Filling uneven disjoint ranges must match a single fill
+    int *c = spda_reserve(int, 10000);
+    size_t cuts[] = {0, 1, 777, 1024, 5000, 9999, 10000};
+    for (size_t i = 0; i + 1 < CARRAY_LEN(cuts); i++) {
+        spda_fill_int(c, cuts[i], cuts[i + 1] - cuts[i], 1234, -5, 5);
+    }
+    spda_set_length(c, 10000);
+    TEST_ASSERT(memcmp(a, c, 10000 * sizeof(int)) == 0,
+                "Split range fills match a single fill",
+                "Split range fills differ from a single fill");
+
+    // An inverted range is rejected instead of wrapping to 2^64 values
+    int *inverted = spda_rand_int(10, 1234, 5, -5);
+    TEST_ASSERT(inverted == NULL,
+                "Inverted integer range is rejected",
+                "Inverted integer range was accepted");
+
+    double *normal = spda_rand_normal(100000, 7, 10.0, 2.0);
+    double mean = 0.0, var = 0.0;
+    spda_foreach(double, normal, x) mean += x;
+    mean /= spda_len(normal);
+    spda_foreach(double, normal, x) var += (x - mean) * (x - mean);
+    var /= spda_len(normal);
+    TEST_ASSERT(fabs(mean - 10.0) < 0.05 && fabs(sqrt(var) - 2.0) < 0.05,
+                "Normal generator matches the requested moments",
+                "Normal generator moments are off");
+
+    int *perm = spda_rand_permutation(1000, 99);
+    int *seen = spda_reserve(int, 1000);
+    memset(seen, 0, 1000 * sizeof(int));
+    bool is_perm = spda_len(perm) == 1000;
+    spda_foreach(int, perm, x) {
+        if (x < 0 || x >= 1000 || seen[x]++) is_perm = false;
+    }
+    TEST_ASSERT(is_perm,
+                "Shuffled permutation contains every index once",
+                "Shuffled permutation is not a permutation");
+
+    spda_destroy(a);
+    spda_destroy(b);
+    spda_destroy(c);
+    spda_destroy(normal);
+    spda_destroy(perm);
+    spda_destroy(seen);
+}
+
+void test_set_operations() {
+    printf("\nTesting sorted set operations...\n");
+    int *a = spda_create(int);
+    int *b = spda_create(int);
+    spda_append_many(a, 1, 3, 5, 7, 9, 11);
+    spda_append_many(b, 3, 4, 5, 6, 11, 12);
+
+    int expected_union[] = {1, 3, 4, 5, 6, 7, 9, 11, 12};
+    int expected_inter[] = {3, 5, 11};
+    int expected_diff[] = {1, 7, 9};
+    int expected_symdiff[] = {1, 4, 6, 7, 9, 12};
+
+    int *u = spda_union(a, b, comparInt);
+    int *in = spda_intersect(a, b, comparInt);
+    int *d = spda_difference(a, b, comparInt);
+    int *sd = spda_symdiff(a, b, comparInt);
+    bool success = spda_len(u) == CARRAY_LEN(expected_union) && memcmp(u, expected_union, sizeof(expected_union)) == 0
+                && spda_len(in) == CARRAY_LEN(expected_inter) && memcmp(in, expected_inter, sizeof(expected_inter)) == 0
+                && spda_len(d) == CARRAY_LEN(expected_diff) && memcmp(d, expected_diff, sizeof(expected_diff)) == 0
+                && spda_len(sd) == CARRAY_LEN(expected_symdiff) && memcmp(sd, expected_symdiff, sizeof(expected_symdiff)) == 0;
+    TEST_ASSERT(success,
+                "Union, intersection, difference and symmetric difference are correct",
+                "Set operation results did not match");
+
+    // Integer intersection on both the SIMD scan and the galloping path
+    int *big = spda_create(int), *mid = spda_create(int), *tiny = spda_create(int);
+    for (int i = 0; i < 100000; i++) spda_append(big, i * 2);
+    for (int i = 0; i < 50000; i++) spda_append(mid, i * 3);
+    spda_append_many(tiny, -4, 0, 6, 7, 199998, 200000);
+    int *scan = spda_intersect_int(big, mid);
+    int *scan_ref = spda_intersect(big, mid, comparInt);
+    int *gallop = spda_intersect_int(tiny, big);
+    success = spda_len(scan) == spda_len(scan_ref) && memcmp(scan, scan_ref, spda_len(scan) * sizeof(int)) == 0
+           && spda_len(gallop) == 3 && gallop[0] == 0 && gallop[1] == 6 && gallop[2] == 199998;
+    TEST_ASSERT(success,
+                "Integer intersection matches the generic one",
+                "Integer intersection differs from the generic one");
+
+    // K-way merge of uneven inputs, including an empty one
+    const void *inputs[] = {a, b, tiny, mid, spda_create(int)};
+    int *merged = spda_reserve(int, 1);
+    merged = spda_merge_k(merged, inputs, CARRAY_LEN(inputs), comparInt);
+    size_t total = spda_len(a) + spda_len(b) + spda_len(tiny) + spda_len(mid);
+    success = spda_len(merged) == total;
+    for (size_t i = 1; success && i < spda_len(merged); i++) {
+        if (merged[i - 1] > merged[i]) success = false;
+    }
+    int *two_way = spda_merge(a, b, comparInt);
+    success = success && spda_len(two_way) == 12 && two_way[0] == 1 && two_way[11] == 12;
+    TEST_ASSERT(success,
+                "Two-way and k-way merges produce sorted output of the right size",
+                "Merge output is unsorted or has the wrong size");
+
+    spda_destroy((void *)inputs[4]);
+    spda_destroy(merged);
+    spda_destroy(two_way);
+    spda_destroy(scan);
+    spda_destroy(scan_ref);
+    spda_destroy(gallop);
+    spda_destroy(big);
+    spda_destroy(mid);
+    spda_destroy(tiny);
+    spda_destroy(u);
+    spda_destroy(in);
+    spda_destroy(d);
+    spda_destroy(sd);
+    spda_destroy(a);
+    spda_destroy(b);
+}
+
+void test_string_array() {
+    printf("\nTesting string arrays...\n");
+    SpdaStrs *strs = spda_strs_create(false);
+    const char *words[] = {"pear", "apple", "fig", "applesauce", "banana", "apple", ""};
+    for (size_t i = 0; i < CARRAY_LEN(words); i++) spda_strs_push(strs, words[i]);
+    spda_strs_push(strs, spda_strs_get(strs, 4));            // source inside the buffer
+    bool success = spda_strs_len(strs) == 8 && strcmp(spda_strs_get(strs, 7), "banana") == 0
+                && strcmp(spda_strs_get(strs, 3), "applesauce") == 0 && !strs->sorted;
+    TEST_ASSERT(success,
+                "Strings are stored contiguously and read back",
+                "Stored strings did not read back");
+
+    spda_strs_sort(strs);
+    const char *expected[] = {"", "apple", "apple", "applesauce", "banana", "banana", "fig", "pear"};
+    success = strs->sorted;
+    for (size_t i = 0; success && i < CARRAY_LEN(expected); i++) {
+        if (strcmp(spda_strs_get(strs, i), expected[i]) != 0) success = false;
+    }
+    size_t fig = spda_strs_find(strs, "fig");
+    success = success && fig == 6 && spda_strs_find(strs, "grape") == SPDA_STRS_NPOS
+           && strcmp(spda_strs_get(strs, spda_strs_find(strs, "apple")), "apple") == 0;
+    TEST_ASSERT(success,
+                "Prefix sort orders like strcmp and binary search finds keys",
+                "String sort or search was wrong");
+
+    // Interning returns the existing index, also after a sort and through bulk loading
+    SpdaStrs *interned = spda_strs_create(true);
+    const char text[] = "delta\r\nalpha\ncharlie\nalpha\nbravo\ndelta";
+    size_t added = spda_strs_load(interned, text, sizeof(text) - 1);
+    success = added == 4 && spda_strs_len(interned) == 4 && spda_strs_push(interned, "delta") == 0;
+    for (int i = 0; i < 100; i++) {
+        char name[16];
+        snprintf(name, sizeof(name), "key%d", i % 40);
+        spda_strs_push(interned, name);
+    }
+    spda_strs_sort(interned);
+    success = success && spda_strs_len(interned) == 44 && strcmp(spda_strs_get(interned, 0), "alpha") == 0
+           && strcmp(spda_strs_get(interned, spda_strs_push(interned, "charlie")), "charlie") == 0
+           && spda_strs_find(interned, "key39") != SPDA_STRS_NPOS && spda_strs_len(interned) == 44;
+    TEST_ASSERT(success,
+                "Interning deduplicates pushed and loaded strings",
+                "Interned strings were duplicated or lost");
+
+    // Long keys probing past a short string that ends exactly at capacity must not read beyond it
+    SpdaStrs *edge = spda_strs_create(true);
+    char filler[256];
+    size_t fill = spda_cap(edge->bytes) - 3;
+    memset(filler, 'f', fill);
+    spda_strs_push_n(edge, filler, fill);
+    spda_strs_push(edge, "a");
+    success = spda_len(edge->bytes) == spda_cap(edge->bytes);
+    for (int i = 0; success && i < 200; i++) {
+        char key[64];
+        snprintf(key, sizeof(key), "a-much-longer-key-than-the-last-stored-one-%d", i);
+        success = spda_strs_find(edge, key) == SPDA_STRS_NPOS;
+    }
+    success = success && spda_strs_find(edge, "a") == 1;
+    TEST_ASSERT(success,
+                "Interned lookups stop at the end of shorter stored strings",
+                "Interned lookup of a long key failed");
+    spda_strs_destroy(edge);
+
+    // An embedded NUL must key the same before and after the table grows
+    SpdaStrs *nul = spda_strs_create(true);
+    size_t first = spda_strs_push_n(nul, "k\0tail", 6);
+    for (int i = 0; i < 100; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "grow%d", i);
+        spda_strs_push(nul, key);
+    }
+    success = spda_strs_push_n(nul, "k\0tail", 6) == first && spda_strs_push(nul, "k") == first
+           && spda_strs_len(nul) == 101;
+    TEST_ASSERT(success,
+                "Embedded NUL interns survive a table rebuild",
+                "Embedded NUL intern was duplicated after a rebuild");
+    spda_strs_destroy(nul);
+
+    // Plain bulk load splits lines in place
+    SpdaStrs *lines = spda_strs_create(false);
+    spda_strs_load(lines, "one\ntwo\r\n\nthree\n", 16);
+    spda_strs_load(lines, "four", 4);
+    size_t used = spda_len(lines->bytes);
+    bool empty_ok = spda_strs_load(lines, "", 0) == 0 && spda_len(lines->bytes) == used;
+    success = empty_ok && spda_strs_len(lines) == 5 && strcmp(spda_strs_get(lines, 1), "two") == 0
+           && spda_strs_get(lines, 2)[0] == '\0' && strcmp(spda_strs_get(lines, 4), "four") == 0
+           && spda_strs_find(lines, "three") == 3;
+    TEST_ASSERT(success,
+                "Bulk loading splits newline delimited text",
+                "Bulk loaded lines were wrong");
+
+    spda_strs_destroy(lines);
+    spda_strs_destroy(interned);
+    spda_strs_destroy(strs);
+}
+
+void test_debug_checks() {
+    printf("\nTesting debug checks...\n");
+    int *a = spda_create(int);
+    for (int i = 0; i < 5; i++) spda_append(a, i * 10);
+    spda_at(a, 2) += 1;
+    bool success = spda_check(a) && spda_at(a, 2) == 21 && spda_at(a, 4) == 40;
+    TEST_ASSERT(success,
+                "Checked indexing reads and writes like plain indexing",
+                "Checked indexing returned the wrong element");
+
+#ifdef SPDA_DEBUG
+    // Growing always moves the array and kills the old block
+    int *stale = a;
+    size_t cap = spda_cap(a);
+    for (size_t i = spda_len(a); i <= cap; i++) spda_append(a, (int)i);
+    success = stale != a && spda_generation(a) == 1 && spda_check(a);
+#if !defined(__SANITIZE_ADDRESS__)
+    success = success && !spda_check(stale) && ((unsigned char *)stale)[0] == SPDA_POISON_BYTE;
+#endif
+    TEST_ASSERT(success,
+                "Resizing retires the old block so stale pointers are detected",
+                "A stale pointer still looked like a live array");
+
+    // Writing one element past capacity trips the guard
+    spda_pop(a);
+    success = ((unsigned char *)a)[spda_len(a) * sizeof(int)] == SPDA_POISON_BYTE;
+#if !defined(__SANITIZE_ADDRESS__)
+    unsigned char *guard = (unsigned char *)a + spda_cap(a) * sizeof(int);
+    guard[0] = 0;
+    success = success && !spda_check(a);
+    guard[0] = SPDA_GUARD_BYTE;
+    success = success && spda_check(a);
+#endif
+    TEST_ASSERT(success,
+                "Guard overwrites are reported and popped slots are poisoned",
+                "Guard or poisoning checks did not fire");
+
+    // The inline typed API goes through the same checks and poisoning
+    char *chars = spda_char_create();
+    chars = spda_char_append(chars, 'x');
+    chars = spda_char_append(chars, 'y');
+    chars = spda_char_append(chars, 'z');
+    char last;
+    spda_char_pop(chars, &last);
+    spda_char_remove(chars, 0);
+    success = last == 'z' && spda_char_len(chars) == 1 && spda_char_get(chars, 0) == 'y'
+           && (unsigned char)chars[1] == SPDA_POISON_BYTE && (unsigned char)chars[2] == SPDA_POISON_BYTE;
+    TEST_ASSERT(success,
+                "Typed pop and remove poison vacated slots in debug builds",
+                "Typed API skipped the debug poisoning");
+    spda_char_destroy(chars);
+#else
+    success = spda_generation(a) == 0 && FIELD_COUNT == 3;
+    TEST_ASSERT(success,
+                "Release layout carries no debug fields",
+                "Debug fields leaked into the release layout");
+#endif
+
+    spda_destroy(a);
+}
+
+void test_shared_memory() {
+    printf("\nTesting shared-memory arrays...\n");
+    char name[64];
+    snprintf(name, sizeof(name), "/spda_test_%p", (void *)name);
+
+    // Two attachments in one process map the object at different addresses
+    SpdaShm *writer = spda_shm_create(name, sizeof(int), 4, 1 << 20);
+    SpdaShm *reader = spda_shm_attach(name, false);
+    bool success = writer && reader && spda_shm_data(writer) != spda_shm_data(reader);
+    TEST_ASSERT(success,
+                "Shared array is created and attached by name",
+                "Failed to create or attach the shared array");
+
+    size_t cap = spda_shm_cap(reader);
+    for (int i = 0; i < 100; i++) spda_shm_append(writer, &i);
+    const int *view = spda_shm_data(reader);
+    success = spda_shm_len(reader) == 100 && spda_shm_cap(reader) > cap && view[0] == 0 && view[99] == 99;
+
+    int fresh = -7;
+    spda_shm_set(writer, 10, &fresh);
+    spda_shm_truncate(writer, 50);
+    int *snap = spda_shm_snapshot(reader);
+    success = success && spda_len(snap) == 50 && snap[10] == -7 && snap[49] == 49;
+    TEST_ASSERT(success,
+                "Readers observe appends, growth, in-place sets and truncation",
+                "Reader view of the shared array was wrong");
+
+    // Zero-copy producer path: write past the length, then publish
+    spda_shm_reserve(writer, 200);
+    int *slots = spda_shm_data(writer);
+    for (int i = 50; i < 200; i++) slots[i] = i * 2;
+    spda_shm_publish(writer, 200);
+    success = spda_shm_len(reader) == 200 && view[199] == 398
+           && !spda_shm_append(reader, &fresh)
+           && spda_shm_attach(name, true) == NULL;
+    TEST_ASSERT(success,
+                "Published writes are visible and the writer role is exclusive",
+                "Publishing or writer exclusivity failed");
+
+    // The mapped data is a read-only spda array in every process
+    SpdaWriter *w = spda_writer_memory();
+    spda_write(w, view, SPDA_TEXT_I32, SPDA_TEXT_CSV);
+    char *csv = spda_writer_release(w);
+    int *parsed = spda_parse(spda_create(int), csv, spda_len(csv), SPDA_TEXT_I32);
+    success = spda_check(view) && spda_len(view) == 200 && spda_cap(view) == spda_shm_cap(reader)
+           && spda_stride(view) == sizeof(int) && spda_len(parsed) == 200 && parsed[199] == 398;
+    TEST_ASSERT(success,
+                "Readers pass the mapped data straight to the spda API",
+                "Mapped data was not a valid spda array");
+    spda_destroy(parsed);
+    spda_destroy(csv);
+
+    // Handing the writer role over keeps the data
+    spda_shm_detach(writer);
+    writer = spda_shm_attach(name, true);
+    success = writer && spda_shm_len(writer) == 200 && spda_shm_append(writer, &fresh)
+           && spda_shm_len(reader) == 201 && spda_shm_unlink(name);
+    TEST_ASSERT(success,
+                "Writer role can be released and taken over",
+                "Writer handover lost data");
+
+    // Anonymous arrays are shared through the descriptor
+    SpdaShm *anon = spda_shm_from(NULL, snap, 0);
+    SpdaShm *anon_reader = anon ? spda_shm_attach_fd(anon->fd, false) : NULL;
+    success = anon_reader && spda_shm_len(anon_reader) == 50
+           && memcmp(spda_shm_data(anon_reader), snap, 50 * sizeof(int)) == 0;
+    TEST_ASSERT(success,
+                "Anonymous shared arrays attach through their descriptor",
+                "Anonymous shared array did not round trip");
+
+    // An object whose creator has not sized it yet is refused, not mapped past its end
+    char unsized[64];
+    snprintf(unsized, sizeof(unsized), "/spda_test_unsized_%p", (void *)unsized);
+    int raw = shm_open(unsized, O_CREAT | O_EXCL | O_RDWR, 0600);
+    success = raw >= 0 && spda_shm_attach(unsized, false) == NULL && spda_shm_attach(unsized, true) == NULL;
+    if (raw >= 0) {
+        close(raw);
+        shm_unlink(unsized);
+    }
+    TEST_ASSERT(success,
+                "Attaching to an unsized object fails cleanly",
+                "Attaching to an unsized object was accepted");
+
+    // A writer that dies inside a seqlock section must not wedge readers or its successor
+    SpdaShm *owner = spda_shm_create(NULL, sizeof(int), 4, 1 << 20);
+    SpdaShm *watch = owner ? spda_shm_attach_fd(owner->fd, false) : NULL;
+    spda_shm_detach(owner);
+    pid_t child = watch ? fork() : -1;
+    if (child == 0) {
+        SpdaShm *crashed = spda_shm_attach_fd(watch->fd, true);
+        int one = 1;
+        if (crashed == NULL || !spda_shm_append(crashed, &one)) _exit(1);
+        *(uint64_t *)((char *)crashed->region + SPDA_SHM_SEQ_OFFSET) += 1;    // left odd, as if killed mid-publish
+        _exit(0);
+    }
+    int status = 1;
+    if (child > 0) waitpid(child, &status, 0);
+    SpdaShm *successor = status == 0 ? spda_shm_attach_fd(watch->fd, true) : NULL;
+    int two = 2;
+    success = successor && spda_shm_len(watch) == 1 && spda_shm_append(successor, &two)
+           && spda_shm_len(watch) == 2 && ((const int *)spda_shm_data(watch))[1] == 2;
+    TEST_ASSERT(success,
+                "A dead writer's open seqlock section is closed on takeover",
+                "Takeover from a dead writer left the seqlock wedged");
+
+    spda_shm_detach(successor);
+    spda_shm_detach(watch);
+    spda_shm_detach(anon_reader);
+    spda_shm_detach(anon);
+    spda_shm_detach(writer);
+    spda_shm_detach(reader);
+    spda_destroy(snap);
+}
+
+void test_text_export() {
+    printf("\nTesting text export...\n");
+    char out[SPDA_TEXT_MAX];
+    spda_format_int(out, -2147483648LL);
+    bool success = strcmp(out, "-2147483648") == 0;
+    spda_format_double(out, 0.1);
+    success = success && strcmp(out, "0.1") == 0;
+    spda_format_double(out, -2.5e-7);
+    success = success && strcmp(out, "-2.5e-07") == 0;
+    spda_format_double(out, 4.9e-324);
+    success = success && strcmp(out, "5e-324") == 0;
+    spda_format_float(out, 0.1f);
+    success = success && strcmp(out, "0.1") == 0;
+    spda_format_double(out, 1.0 / 3);
+    success = success && strtod(out, NULL) == 1.0 / 3;
+    TEST_ASSERT(success,
+                "Values are formatted with the fewest round trip digits",
+                "Formatted value was wrong or not shortest");
+
+    // Ints and doubles round trip through a memory writer and the parser
+    int *ints = spda_create(int);
+    double *reals = spda_create(double);
+    for (int i = 0; i < 1000; i++) {
+        spda_append(ints, (i - 500) * 4099);
+        spda_append(reals, (i - 500) / 7.0 + i * 1e-9);
+    }
+    spda_append(reals, 1e300);
+    spda_append(reals, -4.9e-324);
+
+    SpdaWriter *w = spda_writer_memory();
+    spda_write(w, ints, SPDA_TEXT_I32, SPDA_TEXT_CSV);
+    char *text = spda_writer_release(w);
+    int *ints_back = spda_parse(spda_create(int), text, spda_len(text), SPDA_TEXT_I32);
+    success = spda_len(ints_back) == spda_len(ints) && memcmp(ints, ints_back, spda_len(ints) * sizeof(int)) == 0;
+    spda_destroy(text);
+
+    w = spda_writer_memory();
+    spda_write(w, reals, SPDA_TEXT_F64, SPDA_TEXT_JSON);
+    text = spda_writer_release(w);
+    double *reals_back = spda_parse(spda_create(double), text, spda_len(text), SPDA_TEXT_F64);
+    success = success && text[0] == '[' && spda_len(reals_back) == spda_len(reals)
+           && memcmp(reals, reals_back, spda_len(reals) * sizeof(double)) == 0;
+    spda_destroy(text);
+    TEST_ASSERT(success,
+                "CSV and JSON output parse back to the same values",
+                "Exported values did not round trip");
+
+    // Tables write a header row, and a FILE sink sees the same bytes
+    float *f = spda_create(float);
+    spda_append(f, 1.5f);
+    spda_append(f, -0.25f);
+    int *ids = spda_create(int);
+    spda_append(ids, 7);
+    spda_append(ids, 8);
+    const void *columns[] = { ids, f };
+    const SpdaTextType types[] = { SPDA_TEXT_I32, SPDA_TEXT_F32 };
+    const char *names[] = { "id", "x" };
+
+    w = spda_writer_memory();
+    spda_write_table(w, columns, types, names, 2, SPDA_TEXT_TSV);
+    spda_write_table(w, columns, types, names, 2, SPDA_TEXT_JSON);
+    text = spda_writer_release(w);
+    success = strcmp(text, "id\tx\n7\t1.5\n8\t-0.25\n{\"id\":[7,8],\"x\":[1.5,-0.25]}\n") == 0;
+
+    // JSON tables parse back column major, keys and all
+    const char *object = strchr(text, '{');
+    double *columns_back = spda_parse(spda_create(double), object, strlen(object), SPDA_TEXT_F64);
+    success = success && spda_len(columns_back) == 4 && columns_back[1] == 8 && columns_back[2] == 1.5
+           && columns_back[3] == -0.25;
+    const char json[] = "{\"a\":[1,2],\"b \\\"c\\\"\":[3,-4]}\n";
+    int *json_back = spda_parse(spda_create(int), json, sizeof(json) - 1, SPDA_TEXT_I32);
+    success = success && spda_len(json_back) == 4 && json_back[1] == 2 && json_back[2] == 3 && json_back[3] == -4;
+    spda_destroy(json_back);
+    spda_destroy(columns_back);
+
+    FILE *file = tmpfile();
+    w = spda_writer_file(file);
+    spda_write_table(w, columns, types, names, 2, SPDA_TEXT_CSV);
+    success = success && spda_writer_destroy(w);
+    char csv[64] = { 0 };
+    rewind(file);
+    fread(csv, 1, sizeof(csv) - 1, file);
+    fclose(file);
+    success = success && strcmp(csv, "id,x\n7,1.5\n8,-0.25\n") == 0;
+
+    // Header names that would split or break a row are quoted
+    const char *awkward[] = { "price, usd", "say \"hi\"" };
+    w = spda_writer_memory();
+    spda_write_table(w, columns, types, awkward, 2, SPDA_TEXT_CSV);
+    spda_write_table(w, columns, types, awkward, 2, SPDA_TEXT_TSV);
+    char *quoted = spda_writer_release(w);
+    success = success && quoted && strcmp(quoted, "\"price, usd\",\"say \"\"hi\"\"\"\n7,1.5\n8,-0.25\n"
+                                                  "price, usd\t\"say \"\"hi\"\"\"\n7\t1.5\n8\t-0.25\n") == 0;
+    spda_destroy(quoted);
+    TEST_ASSERT(success,
+                "Tables are written as TSV, JSON and CSV and JSON tables parse back",
+                "Table output was wrong");
+
+    int *bad = spda_parse(spda_create(int), "1,2,3000000000", 14, SPDA_TEXT_I32);
+    success = spda_len(bad) == 2;
+    TEST_ASSERT(success,
+                "Out of range values stop the parse",
+                "Out of range value was accepted");
+
+    // Long decimals (%f of 1e300, many leading zeros) go through strtod whole
+    char wide[512];
+    int wide_len = snprintf(wide, sizeof(wide), "%f,0.%069d1", 1e300, 0);
+    double *long_back = spda_parse(spda_create(double), wide, (size_t)wide_len, SPDA_TEXT_F64);
+    success = spda_len(long_back) == 2 && long_back[0] == 1e300 && long_back[1] == 1e-70;
+    TEST_ASSERT(success,
+                "Long decimal tokens parse exactly",
+                "Long decimal tokens were rejected or misread");
+
+    spda_destroy(long_back);
+    spda_destroy(bad);
+    spda_destroy(text);
+    spda_destroy(ids);
+    spda_destroy(f);
+    spda_destroy(reals_back);
+    spda_destroy(ints_back);
+    spda_destroy(reals);
+    spda_destroy(ints);
+}
 
 // Main test suite
 int main(void) {
@@ -244,6 +1014,17 @@ int main(void) {
     test_sort_integer();
     test_shrink();
     test_foreach();
+    test_gap_buffer();
+    test_rope();
+    test_typed();
+    test_trim_policy();
+    test_pack();
+    test_random();
+    test_set_operations();
+    test_string_array();
+    test_debug_checks();
+    test_shared_memory();
+    test_text_export();
 
     printf(GREEN"\nAll tests passed successfully!\n"RESET);
     return 0;